@@ -0,0 +1,153 @@
+// Packs the UI bitmaps of Graph Plotter 2 into one file it can map and
+// upload without decoding:
+//
+//	AssetPacker assets.pack homePage.bmp Title.bmp ... keyboardBlackFull.bmp=-1
+//
+// Each bitmap is stored as RGBA, bottom row first as stbi_set_flip_vertically_on_load(1)
+// gives it, with alpha already cleared where the pixel matches its colour key
+// (0 unless given after '='), the way iShowBMP2 does it. Bitmaps may be read
+// from another directory (assets/Title.bmp), but an entry is named by its file
+// name alone, which is what Graph Plotter 2 looks it up by. Pixel data starts
+// on PACK_ALIGNMENT boundaries so a mapped pack hands whole pages to
+// glTexSubImage2D. The layout must match the one in Graph Plotter 2.cpp.
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 4096
+#define PACK_NAME_LENGTH 48
+
+struct PackHeader
+{
+	char magic[4]; // "GPK1"
+	int version;
+	int count;	   // entries following the header
+	int alignment;
+};
+struct PackEntry
+{
+	char name[PACK_NAME_LENGTH]; // file name the bitmap was packed from, without its directory
+	int width, height;
+	int ignoreColor; // colour keyed out, -1 for none
+	int reserved;
+	long long offset; // of width * height * 4 bytes of RGBA
+	long long size;
+};
+
+void keyPixels(unsigned char *image, int width, int height, int ignoreColor)
+{
+	unsigned char *p = image;
+	for (int n = width * height; n > 0; n--, p += 4)
+	{
+		int bgr = p[0] | (p[1] << 8) | (p[2] << 16);
+		p[3] = (bgr == ignoreColor) ? 0 : 255;
+	}
+}
+
+long long alignOffset(long long offset)
+{
+	return (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		printf("usage: AssetPacker out.pack image.bmp[=ignoreColor] ...\n");
+		return 1;
+	}
+
+	int count = argc - 2;
+	PackEntry *entries = (PackEntry *)calloc(count, sizeof(PackEntry));
+	unsigned char **images = (unsigned char **)calloc(count, sizeof(unsigned char *));
+	if (entries == NULL || images == NULL)
+	{
+		printf("Not enough memory\n");
+		return 1;
+	}
+
+	stbi_set_flip_vertically_on_load(1);
+	long long offset = alignOffset(sizeof(PackHeader) + (long long)count * sizeof(PackEntry));
+	for (int i = 0; i < count; i++)
+	{
+		char file[260];
+		strncpy(file, argv[i + 2], sizeof(file) - 1);
+		file[sizeof(file) - 1] = '\0';
+		PackEntry *entry = &entries[i];
+		char *key = strchr(file, '=');
+		if (key != NULL)
+		{
+			*key = '\0';
+			entry->ignoreColor = atoi(key + 1);
+		}
+		const char *name = file;
+		for (const char *c = file; *c != '\0'; c++)
+		{
+			if (*c == '/' || *c == '\\' || *c == ':')
+			{
+				name = c + 1;
+			}
+		}
+		if (strlen(name) >= PACK_NAME_LENGTH)
+		{
+			printf("%s: name longer than %d characters\n", name, PACK_NAME_LENGTH - 1);
+			return 1;
+		}
+		strcpy(entry->name, name);
+		for (int k = 0; k < i; k++)
+		{
+			if (strcmp(entries[k].name, name) == 0 && entries[k].ignoreColor == entry->ignoreColor)
+			{
+				printf("%s: packed twice under the same name\n", file);
+				return 1;
+			}
+		}
+
+		int n;
+		images[i] = stbi_load(file, &entry->width, &entry->height, &n, 4);
+		if (images[i] == NULL)
+		{
+			printf("%s: %s\n", file, stbi_failure_reason());
+			return 1;
+		}
+		keyPixels(images[i], entry->width, entry->height, entry->ignoreColor);
+		entry->offset = offset;
+		entry->size = (long long)entry->width * entry->height * 4;
+		offset = alignOffset(offset + entry->size);
+	}
+
+	FILE *out = fopen(argv[1], "wb");
+	if (out == NULL)
+	{
+		printf("Cannot write %s\n", argv[1]);
+		return 1;
+	}
+	PackHeader header;
+	memcpy(header.magic, "GPK1", 4);
+	header.version = PACK_VERSION;
+	header.count = count;
+	header.alignment = PACK_ALIGNMENT;
+	bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+			  fwrite(entries, sizeof(PackEntry), count, out) == (size_t)count;
+
+	static const char zeros[PACK_ALIGNMENT] = {0};
+	long long written = sizeof(header) + (long long)count * sizeof(PackEntry);
+	for (int i = 0; ok && i < count; i++)
+	{
+		ok = fwrite(zeros, 1, (size_t)(entries[i].offset - written), out) == (size_t)(entries[i].offset - written) &&
+			 fwrite(images[i], 1, (size_t)entries[i].size, out) == (size_t)entries[i].size;
+		written = entries[i].offset + entries[i].size;
+		stbi_image_free(images[i]);
+	}
+	ok = fclose(out) == 0 && ok;
+	if (!ok)
+	{
+		printf("Writing %s failed\n", argv[1]);
+		return 1;
+	}
+	printf("Packed %d bitmaps into %s (%ld bytes)\n", count, argv[1], (long)written);
+	return 0;
+}
@@ -4,12 +4,19 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <ctype.h>
+#include <stdarg.h>
 #include <string>
 
 #define screenWidth 1200
 #define screenHeight 600
-#define MAX_TEXTBOXES 100
+#define INITIAL_TEXTBOXES 100 // box slots allocated up front; the registry doubles past that
 #define MAX_TEXT_LENGTH 100
+#define GRID_MINOR 20			// pixels between light grid lines
+#define GRID_MAJOR 100		// pixels between dark grid lines and axis units
+#define LABEL_MARGIN 30		// axis labels this far outside the window are still laid out
+#define LABEL_CACHE_RANGE 1000 // axis units whose label text is kept formatted
+#define MAX_AXIS_LABELS 64
 /*
 	function iDraw() is called again and again by the system.
 
@@ -32,13 +39,13 @@ int angleY = 565;
 int angleX1 = 320;
 int angleWidth = 32;
 int angleHeight = 32;
-int emptyText[MAX_TEXTBOXES] = {0};
-int drawState[MAX_TEXTBOXES] = {0};
+int *emptyText;
+int *drawState;
 bool showMyself = false;
 bool showAbout = false;
 bool homepage = true;
 bool lightMode = false;
-bool showCurve[MAX_TEXTBOXES];
+bool *showCurve;
 bool showFuncList = false;
 bool toggleTextCursor = false;
 bool onClickFunction = false;
@@ -48,7 +55,7 @@ bool leftAngle = false;
 bool showKeyboard = false;
 bool typeState = false;
 bool highlightedTextBox = false;
-int indexNumber[MAX_TEXTBOXES + 5] = {6};
+int *indexNumber;
 int textBoxWidth = 350;
 int textBoxHeight = 70;
 int textBoxCount = 1;
@@ -75,32 +82,687 @@ int keyboardY = 7;
 int startIndex_X = 111;
 int selectedTextBox = 0;
 int counter = 0;
-double graphColor[MAX_TEXTBOXES][3];
-int colorFlag[MAX_TEXTBOXES];
-int funcType[MAX_TEXTBOXES];
-int funcSpec[MAX_TEXTBOXES][4][7];
-int cursorIndex2[MAX_TEXTBOXES];
-int cursorIndex[MAX_TEXTBOXES];
-char func[MAX_TEXTBOXES][MAX_TEXT_LENGTH];
-char func1[MAX_TEXTBOXES][MAX_TEXT_LENGTH];
-int textBoxPositions[MAX_TEXTBOXES];
+
+// Per-box state lives in parallel arrays indexed by box number, all grown
+// together by ensureRegistryCapacity(). The fields drawFunc() touches every
+// frame (funcType, drawState, showCurve, graphColor, previewFunc, curveCache)
+// stay in their own arrays, apart from the box text.
+int registryCapacity = 0;
+double (*graphColor)[3];
+int *colorFlag;
+int *funcType;
+int (*funcSpec)[4][7];
+int *cursorIndex2;
+int *cursorIndex;
+char (*func)[MAX_TEXT_LENGTH];
+char (*func1)[MAX_TEXT_LENGTH];
+int *textBoxPositions;
+
+// Kinds of curve a text box can parse to
+#define PARSED_NONE 0
+#define PARSED_LINEAR 1
+#define PARSED_SIN 2
+#define PARSED_COS 3
+#define PARSED_TAN 4
+#define PARSED_COT 5
+#define PARSED_COSEC 6
+#define PARSED_SEC 7
+#define PARSED_ASIN 8
+#define PARSED_ACOS 9
+#define PARSED_ATAN 10
+#define PARSED_ACOT 11
+#define PARSED_ACOSEC 12
+#define PARSED_ASEC 13
+#define PARSED_EXP 14
+#define PARSED_LOG 15
+#define PARSED_LN 16
+#define PARSED_QUADRATIC 17
+#define PARSED_CUBIC 18
+#define PARSED_TETRA 19
+#define PARSED_REFERENCE 20 // a * g(x)^power + e over the function of another box
+
+// Result of parsing func[i] once; drawFunc only evaluates it
+struct ParsedFunction
+{
+	int family;		// funcType[i] the record was parsed for
+	int degree;		// funcSpec[i][3][1] the record was parsed for
+	int kind;		// PARSED_*
+	int state;		// drawState to report: 2 drawable, 3 malformed, 0 nothing to draw yet
+	bool checkJump; // skip segments that jump across an asymptote
+	double a, b, c, d, e, base;
+	int source;		   // PARSED_REFERENCE: box whose previewFunc is transformed
+	int sourceVersion; // funcVersion[source] the record was parsed against
+	int power;		   // 1 or 2
+};
+ParsedFunction *parsedFunc;
+ParsedFunction *previewFunc; // last parse that succeeded, drawn while the text is mid-edit
+bool *funcDirty;
+int *funcVersion; // bumped whenever previewFunc[i] changes
+
+// Screen-space samples of one curve, one per pixel column, reused until its
+// function changes or the view is panned outside the sampled columns
+#define CURVE_MARGIN 2				 // extra columns sampled past each window edge
+#define CURVE_SLACK screenWidth		 // columns sampled ahead on each side so short pans reuse samples
+#define SAMPLE_TILE 256				 // columns per tile when several curves are sampled together
+struct CurveCache
+{
+	int version;  // funcVersion[i] the samples were taken for
+	int first;	  // column of screenY[0]
+	int count;	  // columns sampled
+	int capacity; // columns allocated
+	int *screenY;
+	GLuint list;  // display list of the samples as GL_LINES in world pixels, 0 until first built
+};
+CurveCache *curveCache;
+bool *curveReady; // drawFunc scratch: box i has a curve to draw this frame
+int *staleCurves; // drawFunc scratch: boxes whose samples must be retaken
+
+// A box whose text reads "f(x) = a = 2" or "f(x) = b = 3a" defines a
+// parameter that other boxes can use in place of a number.
+#define MAX_PARAM_NAME 16
+struct Parameter
+{
+	bool used;					 // the box holds a parameter definition
+	char name[MAX_PARAM_NAME];
+	double number;				 // the written number, or the factor in front of source
+	char source[MAX_PARAM_NAME]; // parameter this one is defined from, "" for a plain number
+	bool defined;				 // value could be resolved (source known, no cycle)
+	double value;
+	int visit;					 // 0 unvisited, 1 resolving, 2 done
+	double previousValue;		 // value and defined before the current updateParameters() pass
+	bool previousDefined;
+};
+Parameter *parameters;
+char (*funcParams)[2 * MAX_TEXT_LENGTH]; // " a b " : names func[i] referred to at its last parse
+
+// "f(x) = g(x) = 2 sin(x)" names the box's function g and still plots it. Another
+// box can then read "f(x) = 3g(x) + 1" or "f(x) = g(x)^2 + 1". Those names go
+// into funcParams like parameter names, so markParameterUsers() reaches them.
+char (*funcNames)[MAX_PARAM_NAME]; // "" for an unnamed box
+
+// Built-in parameter t, advanced by animate() while the animation runs (F5 pauses it)
+#define ANIMATION_INTERVAL 33 // ms, about 30 frames per second
+double animationTime = 0;
+bool animationPaused = false;
+
+void parseFunction(int i);
 
 double offsetX = 0.0;
 double offsetY = 0.0;
-double offsetX1[MAX_TEXTBOXES] = {0.0};
+double *offsetX1;
 double offsetY1 = 0.0;
 
+// Reallocates one registry array from oldCount to newCount entries, zeroing the new ones
+template <typename T>
+bool growRegistryArray(T *&array, int oldCount, int newCount)
+{
+	T *grown = (T *)realloc(array, newCount * sizeof(T));
+	if (grown == NULL)
+	{
+		return false;
+	}
+	memset(grown + oldCount, 0, (newCount - oldCount) * sizeof(T));
+	array = grown;
+	return true;
+}
+// Makes room for at least count boxes. Returns false, leaving the registry
+// as it was, if memory runs out; callers then refuse to add the box.
+bool ensureRegistryCapacity(int count)
+{
+	if (count <= registryCapacity)
+	{
+		return true;
+	}
+	int capacity = registryCapacity > 0 ? registryCapacity : INITIAL_TEXTBOXES;
+	while (capacity < count)
+	{
+		capacity *= 2;
+	}
+
+	int old = registryCapacity;
+	bool ok = growRegistryArray(funcType, old, capacity) &&
+			  growRegistryArray(drawState, old, capacity) &&
+			  growRegistryArray(showCurve, old, capacity) &&
+			  growRegistryArray(graphColor, old, capacity) &&
+			  growRegistryArray(colorFlag, old, capacity) &&
+			  growRegistryArray(previewFunc, old, capacity) &&
+			  growRegistryArray(curveCache, old, capacity) &&
+			  growRegistryArray(curveReady, old, capacity) &&
+			  growRegistryArray(staleCurves, old, capacity) &&
+			  growRegistryArray(funcVersion, old, capacity) &&
+			  growRegistryArray(parsedFunc, old, capacity) &&
+			  growRegistryArray(funcDirty, old, capacity) &&
+			  growRegistryArray(funcSpec, old, capacity) &&
+			  growRegistryArray(parameters, old, capacity) &&
+			  growRegistryArray(funcParams, old, capacity) &&
+			  growRegistryArray(funcNames, old, capacity) &&
+			  growRegistryArray(func, old, capacity) &&
+			  growRegistryArray(func1, old, capacity) &&
+			  growRegistryArray(emptyText, old, capacity) &&
+			  growRegistryArray(indexNumber, old, capacity) &&
+			  growRegistryArray(cursorIndex, old, capacity) &&
+			  growRegistryArray(cursorIndex2, old, capacity) &&
+			  growRegistryArray(textBoxPositions, old, capacity) &&
+			  growRegistryArray(offsetX1, old, capacity);
+	if (!ok)
+	{
+		// Arrays grown before the failure keep their extra room; the capacity stays at the smallest
+		return false;
+	}
+
+	for (int i = old; i < capacity; i++)
+	{
+		indexNumber[i] = 6; // length of "f(x) ="
+	}
+	registryCapacity = capacity;
+	return true;
+}
+
+// Leveled console log. Calls below LOG_COMPILED_LEVEL compile to nothing and
+// calls below logLevel cost one comparison. Messages are formatted into a
+// ring of fixed slots by the input thread and printed by logWriter() on its
+// own thread, so a slow console never holds up mouse handling. F6 switches
+// the debug traces on and off.
+#define LOG_DEBUG 0
+#define LOG_INFO 1
+#define LOG_ERROR 2
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL LOG_DEBUG
+#endif
+#define LOG_SLOTS 256		// power of two
+#define LOG_MESSAGE_LENGTH 128
+#define LOG_FLUSH_INTERVAL 50 // ms the writer sleeps when nothing wakes it
+#define logMessage(level, ...)                                              \
+	do                                                                      \
+	{                                                                       \
+		if ((level) >= LOG_COMPILED_LEVEL && (level) >= logLevel)           \
+		{                                                                   \
+			logWrite(__VA_ARGS__);                                          \
+		}                                                                   \
+	} while (0)
+int logLevel = LOG_INFO;
+char logRing[LOG_SLOTS][LOG_MESSAGE_LENGTH];
+volatile LONG logHead = 0; // next slot the input thread fills; only it writes this
+volatile LONG logTail = 0; // next slot the writer prints; only it writes this
+volatile LONG logDropped = 0;
+HANDLE logWakeup = NULL;
+bool logStarted = false;
+
+void logWrite(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	if (!logStarted)
+	{
+		vprintf(format, args);
+		va_end(args);
+		return;
+	}
+
+	LONG head = logHead;
+	LONG tail = logTail;
+	if (head - tail >= LOG_SLOTS)
+	{
+		InterlockedIncrement(&logDropped);
+		va_end(args);
+		return;
+	}
+	vsnprintf(logRing[head & (LOG_SLOTS - 1)], LOG_MESSAGE_LENGTH, format, args);
+	va_end(args);
+	// The exchange is a full barrier, so the text is in place before the slot is published
+	InterlockedExchange(&logHead, head + 1);
+	if (head == tail)
+	{
+		SetEvent(logWakeup);
+	}
+}
+DWORD WINAPI logWriter(LPVOID)
+{
+	for (;;)
+	{
+		WaitForSingleObject(logWakeup, LOG_FLUSH_INTERVAL);
+		LONG tail = logTail;
+		while (tail != logHead)
+		{
+			fputs(logRing[tail & (LOG_SLOTS - 1)], stdout);
+			tail++;
+			InterlockedExchange(&logTail, tail);
+		}
+		LONG dropped = InterlockedExchange(&logDropped, 0);
+		if (dropped > 0)
+		{
+			printf("(%ld log messages dropped)\n", (long)dropped);
+		}
+		fflush(stdout);
+	}
+	return 0;
+}
+// Until this runs, or if the thread cannot be started, messages are printed directly
+void startLogWriter()
+{
+	logWakeup = CreateEventA(NULL, FALSE, FALSE, NULL);
+	if (logWakeup == NULL)
+	{
+		return;
+	}
+	HANDLE thread = CreateThread(NULL, 0, logWriter, NULL, 0, NULL);
+	if (thread == NULL)
+	{
+		CloseHandle(logWakeup);
+		return;
+	}
+	CloseHandle(thread);
+	logStarted = true;
+}
+
+// UI bitmaps. Those found in assets.pack (built by AssetPacker.cpp) are
+// used straight from the mapped file. main() starts decoder threads that
+// read and colour-key the rest in the background, the home page's first, so
+// the first frame waits only for those. A bitmap becomes a texture the first time it is drawn:
+// sprites up to ATLAS_MAX_SPRITE pixels tall are shelf-packed into one
+// atlas texture as they arrive, larger ones get a texture each.
+#define SPRITE_HOME_PAGE 0
+#define SPRITE_TITLE 1
+#define SPRITE_BUTTON 2
+#define SPRITE_PLOT_GRAPH 3
+#define SPRITE_ABOUT 4
+#define SPRITE_INSTRUCT 5
+#define SPRITE_BUET 6
+#define SPRITE_MYSELF 7
+#define SPRITE_CIRCLE_WHITE 8
+#define SPRITE_MOON 9
+#define SPRITE_BOOK 10
+#define SPRITE_HOME_BUTTON 11
+#define SPRITE_INSTRUCTIONS_FULL 12
+#define SPRITE_INSTRUCTIONS 13
+#define SPRITE_ANGLE_RIGHT 14
+#define SPRITE_ANGLE_LEFT 15
+#define SPRITE_PLUS 16
+#define SPRITE_ANGLE_DOWN 17
+#define SPRITE_TRIANGLE 18
+#define SPRITE_KEYBOARD 19
+#define SPRITE_KEYBOARD_DOWN 20
+#define SPRITE_KEYBOARD_FULL 21
+#define SPRITE_TEXT_CURSOR 22
+#define SPRITE_COUNT 23
+#define ATLAS_WIDTH 1024
+#define ATLAS_HEIGHT 1024
+#define ATLAS_MAX_SPRITE 256
+#define MAX_DECODE_THREADS 8
+#define ASSET_PACK_FILE "assets.pack"
+struct Sprite
+{
+	const char *file;
+	int ignoreColor; // colour keyed out as in iShowBMP2, -1 for none
+	int width, height; // 0 if the bitmap could not be read
+	GLuint texture;	   // 0 if no texture could be made; drawn with iShowBMP2 instead
+	double u0, v0, u1, v1;
+	unsigned char *pixels; // decoded, colour-keyed RGBA waiting to be uploaded
+	HANDLE decoded;		   // signalled once pixels is filled in; NULL if the bitmap is decoded on first draw
+	bool uploaded;
+	bool packed; // pixels point into the mapped asset pack
+};
+Sprite sprites[SPRITE_COUNT] = {
+	{"homePage.bmp", 0},
+	{"Title.bmp", 0},
+	{"button.bmp", 0},
+	{"PlotGraph.bmp", 0},
+	{"About.bmp", 0},
+	{"Instruct.bmp", 0},
+	{"BUET.bmp", 0},
+	{"Myself.bmp", 0},
+	{"circleWhite.bmp", 0},
+	{"moon.bmp", 0},
+	{"book.bmp", 0},
+	{"homeButton.bmp", 0},
+	{"InstructionsFull.bmp", 0},
+	{"Instructions.bmp", 0},
+	{"angleWhiteright.bmp", 0},
+	{"angleWhiteleft.bmp", 0},
+	{"plusWhite.bmp", 0},
+	{"angleDownWhite.bmp", 0},
+	{"triangle.bmp", 0},
+	{"keyboardBlack.bmp", 0},
+	{"keyBoardBlackDown.bmp", 0},
+	{"keyboardBlackFull.bmp", -1},
+	{"textCursor.bmp", 0},
+};
+// designHome() draws these; they are decoded before everything else
+int homeSprites[] = {SPRITE_HOME_PAGE, SPRITE_TITLE, SPRITE_BUTTON, SPRITE_PLOT_GRAPH, SPRITE_ABOUT, SPRITE_INSTRUCT, SPRITE_BUET};
+int decodeOrder[SPRITE_COUNT];
+int decodeCount = 0; // bitmaps in decodeOrder, the ones the pack did not have
+volatile LONG nextDecode = 0;
+int decodeThreads = 0;
+
+// Layout of assets.pack; must match AssetPacker.cpp. Pixel data is RGBA,
+// bottom row first, already colour-keyed with the entry's ignoreColor.
+#define PACK_VERSION 1
+#define PACK_NAME_LENGTH 48
+struct PackHeader
+{
+	char magic[4]; // "GPK1"
+	int version;
+	int count;
+	int alignment;
+};
+struct PackEntry
+{
+	char name[PACK_NAME_LENGTH];
+	int width, height;
+	int ignoreColor;
+	int reserved;
+	long long offset;
+	long long size;
+};
+int packedSprites = 0;
+
+GLuint atlasTexture = 0;
+bool atlasFull = false; // the atlas could not be made or has no room left
+int shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+DWORD programStart;
+bool firstFrameDrawn = false;
+
+int nextPowerOfTwo(int n)
+{
+	int p = 1;
+	while (p < n)
+	{
+		p *= 2;
+	}
+	return p;
+}
+void decodeSprite(int k)
+{
+	int n;
+	sprites[k].pixels = stbi_load(sprites[k].file, &sprites[k].width, &sprites[k].height, &n, 4);
+	if (sprites[k].pixels == NULL)
+	{
+		sprites[k].width = sprites[k].height = 0;
+		return;
+	}
+	iColorKeyPixels(sprites[k].pixels, sprites[k].width * sprites[k].height, sprites[k].ignoreColor);
+}
+// Points every sprite the pack holds, with the same colour key, at its pixels
+// in the mapped file. The mapping stays open for the life of the program.
+void mapAssetPack()
+{
+	HANDLE file = CreateFileA(ASSET_PACK_FILE, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+	DWORD size = GetFileSize(file, NULL);
+	HANDLE mapping = size >= sizeof(PackHeader) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	const char *view = mapping != NULL ? (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+	CloseHandle(file);
+	if (mapping != NULL)
+	{
+		CloseHandle(mapping); // the view keeps the mapping alive
+	}
+
+	const PackHeader *header = (const PackHeader *)view;
+	if (view == NULL || memcmp(header->magic, "GPK1", 4) != 0 || header->version != PACK_VERSION ||
+		header->count < 0 || header->count > (long long)((size - sizeof(PackHeader)) / sizeof(PackEntry)))
+	{
+		if (view != NULL)
+		{
+			UnmapViewOfFile(view);
+		}
+		return;
+	}
+
+	const PackEntry *entries = (const PackEntry *)(view + sizeof(PackHeader));
+	for (int i = 0; i < header->count; i++)
+	{
+		const PackEntry *entry = &entries[i];
+		if (entry->width <= 0 || entry->height <= 0 || entry->size != (long long)entry->width * entry->height * 4 ||
+			entry->offset < 0 || entry->offset + entry->size > (long long)size)
+		{
+			continue;
+		}
+		for (int k = 0; k < SPRITE_COUNT; k++)
+		{
+			if (!sprites[k].packed && sprites[k].ignoreColor == entry->ignoreColor &&
+				strncmp(sprites[k].file, entry->name, PACK_NAME_LENGTH) == 0)
+			{
+				sprites[k].pixels = (unsigned char *)(view + entry->offset);
+				sprites[k].width = entry->width;
+				sprites[k].height = entry->height;
+				sprites[k].packed = true;
+				packedSprites++;
+			}
+		}
+	}
+}
+// Decoder thread: takes bitmaps in decodeOrder until none are left. Runs no
+// GL calls and writes no log, both of which belong to the main thread.
+DWORD WINAPI spriteDecoder(LPVOID)
+{
+	for (;;)
+	{
+		LONG index = InterlockedIncrement(&nextDecode) - 1;
+		if (index >= decodeCount)
+		{
+			break;
+		}
+		int k = decodeOrder[index];
+		decodeSprite(k);
+		SetEvent(sprites[k].decoded);
+	}
+	return 0;
+}
+void startSpriteDecoding()
+{
+	mapAssetPack();
+	// Set once here, before any decoder reads it
+	stbi_set_flip_vertically_on_load(1);
+
+	bool queued[SPRITE_COUNT] = {false};
+	for (int i = 0; i < (int)(sizeof(homeSprites) / sizeof(homeSprites[0])); i++)
+	{
+		if (!sprites[homeSprites[i]].packed)
+		{
+			decodeOrder[decodeCount++] = homeSprites[i];
+		}
+		queued[homeSprites[i]] = true;
+	}
+	for (int k = 0; k < SPRITE_COUNT; k++)
+	{
+		if (!queued[k] && !sprites[k].packed)
+		{
+			decodeOrder[decodeCount++] = k;
+		}
+	}
+
+	bool eventsMade = true;
+	for (int i = 0; i < decodeCount; i++)
+	{
+		int k = decodeOrder[i];
+		sprites[k].decoded = CreateEventA(NULL, TRUE, FALSE, NULL);
+		eventsMade = eventsMade && sprites[k].decoded != NULL;
+	}
+
+	SYSTEM_INFO system;
+	GetSystemInfo(&system);
+	int threads = system.dwNumberOfProcessors;
+	if (threads > MAX_DECODE_THREADS)
+	{
+		threads = MAX_DECODE_THREADS;
+	}
+	if (threads > decodeCount)
+	{
+		threads = decodeCount;
+	}
+	for (int t = 0; eventsMade && t < threads; t++)
+	{
+		HANDLE thread = CreateThread(NULL, 0, spriteDecoder, NULL, 0, NULL);
+		if (thread != NULL)
+		{
+			CloseHandle(thread);
+			decodeThreads++;
+		}
+	}
+
+	// Without a decoder every bitmap is decoded by drawSprite() when first drawn
+	if (decodeThreads == 0)
+	{
+		for (int k = 0; k < SPRITE_COUNT; k++)
+		{
+			if (sprites[k].decoded != NULL)
+			{
+				CloseHandle(sprites[k].decoded);
+				sprites[k].decoded = NULL;
+			}
+		}
+	}
+}
+GLuint createSpriteTexture(const unsigned char *pixels, int width, int height)
+{
+	GLuint texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	return texture;
+}
+// Finds room for a width x height sprite on the atlas shelves, creating the atlas on first use
+bool placeInAtlas(int width, int height, int maxSize, int *x, int *y)
+{
+	if (atlasFull || width > ATLAS_WIDTH || height > ATLAS_MAX_SPRITE)
+	{
+		return false;
+	}
+	if (atlasTexture == 0)
+	{
+		if (ATLAS_WIDTH > maxSize || ATLAS_HEIGHT > maxSize)
+		{
+			atlasFull = true;
+			return false;
+		}
+		atlasTexture = createSpriteTexture(NULL, ATLAS_WIDTH, ATLAS_HEIGHT);
+	}
+	if (shelfX + width > ATLAS_WIDTH)
+	{
+		shelfY += shelfHeight;
+		shelfX = 0;
+		shelfHeight = 0;
+	}
+	if (shelfY + height > ATLAS_HEIGHT)
+	{
+		return false;
+	}
+	*x = shelfX;
+	*y = shelfY;
+	shelfX += width;
+	if (height > shelfHeight)
+	{
+		shelfHeight = height;
+	}
+	return true;
+}
+// Turns a decoded sprite into a texture, or a region of the atlas, and frees its pixels
+void uploadSprite(Sprite *sprite)
+{
+	sprite->uploaded = true;
+	if (sprite->pixels == NULL)
+	{
+		return;
+	}
+
+	GLint maxSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	int x, y;
+	if (placeInAtlas(sprite->width, sprite->height, maxSize, &x, &y))
+	{
+		glBindTexture(GL_TEXTURE_2D, atlasTexture);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, sprite->width, sprite->height, GL_RGBA, GL_UNSIGNED_BYTE, sprite->pixels);
+		sprite->texture = atlasTexture;
+		sprite->u0 = (double)x / ATLAS_WIDTH;
+		sprite->v0 = (double)y / ATLAS_HEIGHT;
+		sprite->u1 = (double)(x + sprite->width) / ATLAS_WIDTH;
+		sprite->v1 = (double)(y + sprite->height) / ATLAS_HEIGHT;
+	}
+	else
+	{
+		// A texture of its own, padded to powers of two
+		int width = nextPowerOfTwo(sprite->width);
+		int height = nextPowerOfTwo(sprite->height);
+		if (width <= maxSize && height <= maxSize)
+		{
+			sprite->texture = createSpriteTexture(NULL, width, height);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, sprite->width, sprite->height, GL_RGBA, GL_UNSIGNED_BYTE, sprite->pixels);
+			sprite->u0 = sprite->v0 = 0;
+			sprite->u1 = (double)sprite->width / width;
+			sprite->v1 = (double)sprite->height / height;
+		}
+	}
+	if (!sprite->packed)
+	{
+		stbi_image_free(sprite->pixels);
+	}
+	sprite->pixels = NULL;
+
+	// Texels are drawn as stored, not tinted by the current iSetColor
+	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+}
+// Draws a UI bitmap with its lower left corner at (x, y), like iShowBMP2
+void drawSprite(int id, int x, int y)
+{
+	Sprite *sprite = &sprites[id];
+	if (!sprite->uploaded)
+	{
+		if (sprite->decoded != NULL)
+		{
+			WaitForSingleObject(sprite->decoded, INFINITE);
+			CloseHandle(sprite->decoded);
+			sprite->decoded = NULL;
+		}
+		else if (!sprite->packed)
+		{
+			decodeSprite(id);
+		}
+		uploadSprite(sprite);
+	}
+	if (sprite->width == 0)
+	{
+		return;
+	}
+	if (sprite->texture == 0)
+	{
+		iShowBMP2(x, y, (char *)sprite->file, sprite->ignoreColor);
+		return;
+	}
+
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, sprite->texture);
+	glBegin(GL_QUADS);
+	glTexCoord2d(sprite->u0, sprite->v0);
+	glVertex2i(x, y);
+	glTexCoord2d(sprite->u1, sprite->v0);
+	glVertex2i(x + sprite->width, y);
+	glTexCoord2d(sprite->u1, sprite->v1);
+	glVertex2i(x + sprite->width, y + sprite->height);
+	glTexCoord2d(sprite->u0, sprite->v1);
+	glVertex2i(x, y + sprite->height);
+	glEnd();
+	glDisable(GL_TEXTURE_2D);
+}
+
 void designHome()
 {
-	iShowBMP2(0, 0, "homePage.bmp", 0.0);
-	iShowBMP2(175, 350 + 40, "Title.bmp", 0.0);
-	iShowBMP2(875, 150 - 40, "button.bmp", 0.0);
-	iShowBMP2(875, 50 - 40, "button.bmp", 0.0);
-	iShowBMP2(875, 250 - 40, "button.bmp", 0.0);
-	iShowBMP2(890 + 5, 205 + 15, "PlotGraph.bmp", 0.0);
-	iShowBMP2(890 + 5 + 30, 105 + 10, "About.bmp", 0.0);
-	iShowBMP2(890 + 5, 5 + 15 + 10, "Instruct.bmp", 0.0);
-	iShowBMP2(1000, 400, "BUET.bmp", 0.0);
+	drawSprite(SPRITE_HOME_PAGE, 0, 0);
+	drawSprite(SPRITE_TITLE, 175, 350 + 40);
+	drawSprite(SPRITE_BUTTON, 875, 150 - 40);
+	drawSprite(SPRITE_BUTTON, 875, 50 - 40);
+	drawSprite(SPRITE_BUTTON, 875, 250 - 40);
+	drawSprite(SPRITE_PLOT_GRAPH, 890 + 5, 205 + 15);
+	drawSprite(SPRITE_ABOUT, 890 + 5 + 30, 105 + 10);
+	drawSprite(SPRITE_INSTRUCT, 890 + 5, 5 + 15 + 10);
+	drawSprite(SPRITE_BUET, 1000, 400);
 }
 
 void myself()
@@ -109,8 +771,8 @@ void myself()
 	{
 		iSetColor(0, 0, 0);
 		iFilledRectangle(0, 0, 1200, 600);
-		iShowBMP2(80, 0, "Myself.bmp", 0.0);
-		iShowBMP2(1150, 550, "circleWhite.bmp", 0.0);
+		drawSprite(SPRITE_MYSELF, 80, 0);
+		drawSprite(SPRITE_CIRCLE_WHITE, 1150, 550);
 	}
 }
 
@@ -121,24 +783,24 @@ void drawIcons()
 
 	iSetColor(255, 87, 51);
 	iFilledCircle(1167, 569 - 2, 20);
-	iShowBMP2(1150, 550, "moon.bmp", 0.0);
+	drawSprite(SPRITE_MOON, 1150, 550);
 
 	iSetColor(255, 87, 51);
 	iFilledCircle(1167, 537 - 10 - 2, 20);
-	iShowBMP2(1150, 510, "book.bmp", 0.0);
+	drawSprite(SPRITE_BOOK, 1150, 510);
 
 	iSetColor(255, 87, 51);
 	iFilledCircle(1166, 505 - 20 - 2, 16);
-	iShowBMP2(1150, 480 - 13.7, "homeButton.bmp", 0.0);
+	drawSprite(SPRITE_HOME_BUTTON, 1150, 480 - 13.7);
 }
 void instructions()
 {
 	if (showAbout == true)
 	{
 
-		iShowBMP2(200, 100, "InstructionsFull.bmp", 0.0);
-		iShowBMP2(390, 480, "Instructions.bmp", 0.0);
-		iShowBMP2(970, 520, "circleWhite.bmp", 0.0);
+		drawSprite(SPRITE_INSTRUCTIONS_FULL, 200, 100);
+		drawSprite(SPRITE_INSTRUCTIONS, 390, 480);
+		drawSprite(SPRITE_CIRCLE_WHITE, 970, 520);
 	}
 }
 void instructions2()
@@ -147,21 +809,21 @@ void instructions2()
 	{
 		iSetColor(0, 0, 0);
 		iFilledRectangle(0, 0, 1200, 600);
-		iShowBMP2(200, 100, "InstructionsFull.bmp", 0.0);
-		iShowBMP2(390, 480, "Instructions.bmp", 0.0);
-		iShowBMP2(970, 520, "circleWhite.bmp", 0.0);
+		drawSprite(SPRITE_INSTRUCTIONS_FULL, 200, 100);
+		drawSprite(SPRITE_INSTRUCTIONS, 390, 480);
+		drawSprite(SPRITE_CIRCLE_WHITE, 970, 520);
 	}
 }
 void initializeArray()
 {
-	for (int i = 1; i < MAX_TEXTBOXES; i++)
+	for (int i = 1; i < registryCapacity; i++)
 	{
 		funcType[i] = 0;
 	}
 }
 void initializeCursorIndex()
 {
-	for (int i = 0; i < MAX_TEXTBOXES + 5; i++)
+	for (int i = 0; i < registryCapacity; i++)
 	{
 		cursorIndex[i] = 105 + indexNumber[selectedTextBox];
 		cursorIndex2[i] = 0;
@@ -189,50 +851,101 @@ int countDigits(int num)
 }
 void initializeIndex()
 {
-	for (int i = 1; i < MAX_TEXTBOXES + 5; i++)
+	for (int i = 1; i < registryCapacity; i++)
 	{
 		indexNumber[i] = 6;
 	}
 }
-void drawSquares(double lineWidth)
+// Index of the first grid line at or past coordinate lo, for lines every spacing units
+int firstGridIndex(double lo, int spacing)
 {
-	// Set line color to darker gray
-	iSetColor(80, 80, 80);
-
-	// Draw horizontal lines for centimeter squares
-	for (int i = -100000; i <= 100000; i += 20)
+	return (int)ceil(lo / spacing);
+}
+// Every line of one grid style that crosses the window, sent as a single GL_LINES batch
+void drawGridLines(int spacing, double lineWidth)
+{
+	glLineWidth(lineWidth > 0.0 ? lineWidth : 1.0);
+	glBegin(GL_LINES);
+	for (int k = firstGridIndex(offsetY, spacing); k * spacing - offsetY <= screenHeight; k++)
 	{
-		iLine(0, i - offsetY, 100000, i - offsetY, lineWidth);
+		glVertex2d(0, k * spacing - offsetY);
+		glVertex2d(screenWidth, k * spacing - offsetY);
 	}
-
-	// Draw vertical lines for centimeter squares
-	for (int i = -100000; i <= 100000; i += 20)
+	for (int k = firstGridIndex(offsetX, spacing); k * spacing - offsetX <= screenWidth; k++)
 	{
-		iLine(i - offsetX, 0, i - offsetX, 100000, lineWidth);
+		glVertex2d(k * spacing - offsetX, 0);
+		glVertex2d(k * spacing - offsetX, screenHeight);
 	}
+	glEnd();
+	glLineWidth(1.0);
+}
+void drawSquares(double lineWidth)
+{
+	// Set line color to darker gray
+	iSetColor(80, 80, 80);
+	drawGridLines(GRID_MINOR, lineWidth);
 }
 void darkLine(double lineWidth)
 {
-	for (int i = -100000; i <= 100000; i += 100)
+	iSetColor(180, 180, 180); // Darker color
+	drawGridLines(GRID_MAJOR, lineWidth);
+}
+// "%d" text for axis unit j; units within LABEL_CACHE_RANGE are formatted once and kept
+char *axisLabel(int j)
+{
+	static char cache[2 * LABEL_CACHE_RANGE + 1][8];
+	static char scratch[12];
+	if (j < -LABEL_CACHE_RANGE || j > LABEL_CACHE_RANGE)
 	{
-		iSetColor(180, 180, 180); // Darker color
-		iLine(0, i - offsetY, iScreenWidth, i - offsetY, lineWidth);
+		sprintf(scratch, "%d", j);
+		return scratch;
 	}
-	for (int i = -100000; i <= 100000; i += 100)
+	char *label = cache[j + LABEL_CACHE_RANGE];
+	if (label[0] == '\0')
 	{
-		iSetColor(180, 180, 180); // Darker color
-		iLine(i - offsetX, 0, i - offsetX, iScreenHeight, lineWidth);
+		sprintf(label, "%d", j);
 	}
+	return label;
+}
+struct AxisLabel
+{
+	int j;
+	int textX, textY;
+	bool boxed;
+	int boxX, boxY, boxWidth, boxHeight;
+};
+AxisLabel axisLabels[MAX_AXIS_LABELS];
+int axisLabelCount = 0;
+void addAxisLabel(int j, int textX, int textY, bool boxed, int boxX, int boxY, int boxWidth, int boxHeight)
+{
+	if (axisLabelCount == MAX_AXIS_LABELS)
+	{
+		return;
+	}
+	AxisLabel *label = &axisLabels[axisLabelCount++];
+	label->j = j;
+	label->textX = textX;
+	label->textY = textY;
+	label->boxed = boxed;
+	label->boxX = boxX;
+	label->boxY = boxY;
+	label->boxWidth = boxWidth;
+	label->boxHeight = boxHeight;
 }
 void drawLabel()
 {
-	for (int i = screenWidth / 2, j = 0; i <= 100000; i += 100, j += 1)
+	axisLabelCount = 0;
+
+	// x axis: unit j sits at screenWidth / 2 + 100 * j, so only the j that land in the window are visited
+	int first = (int)floor((offsetX - screenWidth / 2 - LABEL_MARGIN) / GRID_MAJOR);
+	int last = (int)ceil((offsetX + screenWidth / 2 + LABEL_MARGIN) / GRID_MAJOR);
+	for (int j = first; j <= last; j++)
 	{
-		char label[5];
-		if (j != 0)
-		{
-			int textX, textY, textWidth, textHeight;
+		int i = screenWidth / 2 + GRID_MAJOR * j;
+		int textX, textY, textWidth, textHeight;
 
+		if (j > 0)
+		{
 			if (offsetX > -496 && offsetY < -303)
 			{
 				// Adjust position when conditions are met
@@ -255,23 +968,10 @@ void drawLabel()
 				textWidth = 17;
 				textHeight = 13;
 			}
-
-			iSetColor(r, g, b);
-			iFilledRectangle(textX, textY, textWidth, textHeight);
-
-			iSetColor(r1, g1, b1);
-			sprintf(label, "%d", j);
-			iText(textX, textY, label, GLUT_BITMAP_HELVETICA_12);
+			addAxisLabel(j, textX, textY, true, textX, textY, textWidth, textHeight);
 		}
-	}
-
-	for (int i = screenWidth / 2, j = 0; i >= -100000; i -= 100, j -= 1)
-	{
-		char label[5];
-		if (j != 0)
+		else if (j < 0)
 		{
-			int textX, textY, textWidth, textHeight;
-
 			if (offsetX < 574 && offsetY < -303)
 			{
 				// Adjust position when conditions are met
@@ -294,28 +994,24 @@ void drawLabel()
 				textWidth = 17;
 				textHeight = 13;
 			}
-
-			iSetColor(r, g, b);
-			iFilledRectangle(textX, textY - 2, textWidth, textHeight);
-
-			iSetColor(r1, g1, b1);
-			sprintf(label, "%d", j);
-			iText(textX, textY, label, GLUT_BITMAP_HELVETICA_12);
+			addAxisLabel(j, textX, textY, true, textX, textY - 2, textWidth, textHeight);
 		}
 		else
 		{
-			iSetColor(r1, g1, b1);
-			sprintf(label, "%d", j);
-			iText(i - 12 - offsetX, screenHeight / 2 - 15 - offsetY, label, GLUT_BITMAP_HELVETICA_12);
+			// The origin is labelled once, without a background
+			addAxisLabel(0, i - 12 - offsetX, screenHeight / 2 - 15 - offsetY, false, 0, 0, 0, 0);
 		}
 	}
 
-	for (int i = screenHeight / 2, j = 0; i <= 100000; i += 100, j += 1)
+	// y axis: unit j sits at screenHeight / 2 + 100 * j
+	first = (int)floor((offsetY - screenHeight / 2 - LABEL_MARGIN) / GRID_MAJOR);
+	last = (int)ceil((offsetY + screenHeight / 2 + LABEL_MARGIN) / GRID_MAJOR);
+	for (int j = first; j <= last; j++)
 	{
-		char label[5];
+		int i = screenHeight / 2 + GRID_MAJOR * j;
 		int textX, textY, textWidth, textHeight;
 
-		if (j != 0)
+		if (j > 0)
 		{
 			if (offsetX < -573 && offsetY > -280)
 			{
@@ -339,26 +1035,13 @@ void drawLabel()
 				textWidth = 15 + 5 * (countDigits(j) - 1);
 				textHeight = 12;
 			}
-
-			iSetColor(r, g, b);
-			iFilledRectangle(textX, textY - 2, textWidth - 4, textHeight);
+			addAxisLabel(j, textX, textY, true, textX, textY - 2, textWidth - 4, textHeight);
 		}
-		iSetColor(r1, g1, b1);
-		sprintf(label, "%d", j);
-		iText(textX, textY, label, GLUT_BITMAP_HELVETICA_12);
-	}
-
-	for (int i = screenHeight / 2, j = 0; i >= -100000; i -= 100, j -= 1)
-	{
-		char label[5];
-		if (j != 0)
+		else if (j < 0)
 		{
-			int textX, textY, textWidth, textHeight;
-
 			if (offsetX < -573 && offsetY < 280)
 			{
 				// Adjust position when conditions are met
-
 				textY = i - 5 - offsetY;
 				textWidth = 20 + 5 * (countDigits(j) - 1);
 				textX = screenWidth - textWidth;
@@ -378,15 +1061,31 @@ void drawLabel()
 				textWidth = 14 + 7 * (countDigits(j) - 1);
 				textHeight = 16;
 			}
+			addAxisLabel(j, textX, textY, true, textX, textY, textWidth + 5, textHeight - 5);
+		}
+	}
 
-			iSetColor(r, g, b);
-			iFilledRectangle(textX, textY, textWidth + 5, textHeight - 5);
-
-			iSetColor(r1, g1, b1);
-			sprintf(label, "%d", j);
-			iText(textX, textY, label, GLUT_BITMAP_HELVETICA_12);
+	// All backgrounds in one batch, then the text on top of them
+	iSetColor(r, g, b);
+	glBegin(GL_QUADS);
+	for (int k = 0; k < axisLabelCount; k++)
+	{
+		AxisLabel *label = &axisLabels[k];
+		if (label->boxed)
+		{
+			glVertex2d(label->boxX, label->boxY);
+			glVertex2d(label->boxX + label->boxWidth, label->boxY);
+			glVertex2d(label->boxX + label->boxWidth, label->boxY + label->boxHeight);
+			glVertex2d(label->boxX, label->boxY + label->boxHeight);
 		}
 	}
+	glEnd();
+
+	iSetColor(r1, g1, b1);
+	for (int k = 0; k < axisLabelCount; k++)
+	{
+		iText(axisLabels[k].textX, axisLabels[k].textY, axisLabel(axisLabels[k].j), GLUT_BITMAP_HELVETICA_12);
+	}
 }
 void showLine()
 {
@@ -401,11 +1100,11 @@ void angle()
 	{
 		if (rightAngle)
 		{
-			iShowBMP2(angleX, angleY, "angleWhiteright.bmp", 0);
+			drawSprite(SPRITE_ANGLE_RIGHT, angleX, angleY);
 		}
 		if (leftAngle)
 		{
-			iShowBMP2(angleX1, angleY, "angleWhiteleft.bmp", 0);
+			drawSprite(SPRITE_ANGLE_LEFT, angleX1, angleY);
 		}
 	}
 	else
@@ -436,7 +1135,7 @@ void add()
 	{
 		if (showFloatingWindow)
 		{
-			iShowBMP2(angleX, angleY, "plusWhite.bmp", 0);
+			drawSprite(SPRITE_PLUS, angleX, angleY);
 		}
 	}
 	else
@@ -640,9 +1339,9 @@ void textBox()
 		sprintf(temp1, "%d", i); // Convert the integer to a string
 		iSetColor(145, 145, 145);
 
-		iShowBMP2(320, windowHeight - textBoxPositions[i] - offsetY1 + 6, "angleDownWhite.bmp", 0.0);
+		drawSprite(SPRITE_ANGLE_DOWN, 320, windowHeight - textBoxPositions[i] - offsetY1 + 6);
 		graphColoring();
-		iShowBMP2(320, windowHeight - textBoxPositions[i] - offsetY1 - 18, "circleWhite.bmp", 0.0);
+		drawSprite(SPRITE_CIRCLE_WHITE, 320, windowHeight - textBoxPositions[i] - offsetY1 - 18);
 
 		if (drawState[i] == 2)
 		{
@@ -685,7 +1384,7 @@ void textBox()
 		{
 			iSetColor(45, 45, 45);
 			iFilledRectangle(1, windowHeight - 39 - textBoxPositions[i] - offsetY1, textBoxWidth - 300, textBoxHeight - 5);
-			iShowBMP2(14, windowHeight - textBoxPositions[i] - offsetY1 - 17, "triangle.bmp", 0);
+			drawSprite(SPRITE_TRIANGLE, 14, windowHeight - textBoxPositions[i] - offsetY1 - 17);
 		}
 
 		// 	iSetColor(r1, g1, b1);
@@ -709,12 +1408,12 @@ void keyboard()
 	{
 		if (showKeyboard == false)
 		{
-			iShowBMP2(keyboardX, keyboardY, "keyboardBlack.bmp", 0);
+			drawSprite(SPRITE_KEYBOARD, keyboardX, keyboardY);
 		}
 		else
 		{
-			iShowBMP2(0, 0 + keyboardHeight, "keyBoardBlackDown.bmp", 0);
-			iShowBMP(0, 0, "keyboardBlackFull.bmp");
+			drawSprite(SPRITE_KEYBOARD_DOWN, 0, 0 + keyboardHeight);
+			drawSprite(SPRITE_KEYBOARD_FULL, 0, 0);
 		}
 	}
 }
@@ -805,7 +1504,7 @@ void textCursor()
 				cursorIndex[selectedTextBox] = 111;
 			}
 
-			iShowBMP2(cursorIndex[selectedTextBox], windowHeight - 20 - textBoxPositions[selectedTextBox] - offsetY1, "textCursor.bmp", 0);
+			drawSprite(SPRITE_TEXT_CURSOR, cursorIndex[selectedTextBox], windowHeight - 20 - textBoxPositions[selectedTextBox] - offsetY1);
 		}
 	}
 }
@@ -823,529 +1522,194 @@ void change()
 		}
 	}
 }
+// On-screen keyboard keys, laid out once from buttonX/numberpadX and found
+// through a coarse grid of screen cells instead of testing every rectangle.
+#define KEY_SHIFT 0 // selects the inverse trig functions (funcType 3)
+#define KEY_COUNT 28
+#define KEY_CELL 32 // grid cell size in pixels
+#define KEY_GRID_COLS (screenWidth / KEY_CELL + 1)
+#define KEY_GRID_ROWS (screenHeight / KEY_CELL + 1)
+#define KEY_CELL_SLOTS 4 // a cell smaller than a key overlaps at most 2 x 2 keys
+struct KeyWidget
+{
+	int x0, y0, x1, y1;		 // hit rectangle, edges included
+	int boxX, boxY;			 // lower left corner of the highlight rectangle
+	const char *text;		 // appended to the box, NULL for KEY_SHIFT
+	int advance;			 // text cursor movement for text, in pixels
+	const char *inverseText; // appended instead while funcType is 3, NULL if the key has no inverse
+	int inverseAdvance;
+};
+KeyWidget keyWidgets[KEY_COUNT];
+signed char keyGrid[KEY_GRID_ROWS][KEY_GRID_COLS][KEY_CELL_SLOTS];
+bool keyGridBuilt = false;
+int hitKey = -1; // keyAt(hitMouseX, hitMouseY)
+int hitMouseX = -1;
+int hitMouseY = -1;
+
+// Left edge of key column col in a block starting at left; columns after the first are inset by 5
+int keyColumnX(int left, int col)
+{
+	return left + buttonWidth * col + (col > 0 ? 5 : 0);
+}
+void setKeyWidget(int k, int left, int bottom, int col, int y0, int y1, int boxY, int boxInset, const char *text, int advance, const char *inverseText, int inverseAdvance)
+{
+	KeyWidget *key = &keyWidgets[k];
+	key->x0 = keyColumnX(left, col);
+	key->x1 = left + buttonWidth * (col + 1);
+	key->y0 = bottom + y0;
+	key->y1 = bottom + y1;
+	key->boxX = key->x0 + boxInset;
+	key->boxY = bottom + boxY;
+	key->text = text;
+	key->advance = advance;
+	key->inverseText = inverseText;
+	key->inverseAdvance = inverseAdvance;
+}
+void buildKeyWidgets()
+{
+	int h = buttonHeight;
+
+	// Function keys: three columns, four rows
+	setKeyWidget(KEY_SHIFT, buttonX, buttonY, 0, 0, h, 0, 0, NULL, 0, NULL, 0);
+	setKeyWidget(1, buttonX, buttonY, 1, 0, h, 0, 0, "ln(", 26, NULL, 0);
+	setKeyWidget(2, buttonX, buttonY, 2, 0, h, 0, 0, ")", 8, NULL, 0);
+	setKeyWidget(3, buttonX, buttonY, 0, h + 5, 2 * h + 5, h + 5, 0, "cosec(", 63, "acosec(", 75);
+	setKeyWidget(4, buttonX, buttonY, 1, h + 5, 2 * h + 5, h + 5, 0, "sec(", 41, "asec(", 52);
+	setKeyWidget(5, buttonX, buttonY, 2, h + 5, 2 * h + 5, h + 5, 0, "cot(", 39, "acot(", 50);
+	setKeyWidget(6, buttonX, buttonY, 0, 2 * h + 7, 3 * h + 5, 2 * h + 9, 0, "sin(", 38, "asin(", 48);
+	setKeyWidget(7, buttonX, buttonY, 1, 2 * h + 7, 3 * h + 5, 2 * h + 9, 0, "cos(", 41, "acos(", 52);
+	setKeyWidget(8, buttonX, buttonY, 2, 2 * h + 7, 3 * h + 5, 2 * h + 9, 0, "tan(", 39, "atan(", 50);
+	setKeyWidget(9, buttonX, buttonY, 0, 3 * h + 7, 4 * h + 5, 3 * h + 12, 0, "x", 11, NULL, 0);
+	setKeyWidget(10, buttonX, buttonY, 1, 3 * h + 7, 4 * h, 3 * h + 12, 0, "pow(", 50, NULL, 0);
+	setKeyWidget(11, buttonX, buttonY, 2, 3 * h + 7, 4 * h, 3 * h + 12, 0, "exp(", 45, NULL, 0);
+
+	// Number pad: four columns, four rows; the last column's highlight sits a few pixels right
+	setKeyWidget(12, numberpadX, numberpadY, 0, 0, h, 0, 0, "0", 11, NULL, 0);
+	setKeyWidget(13, numberpadX, numberpadY, 1, 0, h, 0, 0, ".", 7, NULL, 0);
+	setKeyWidget(14, numberpadX, numberpadY, 2, 0, h, 0, 0, ",", 7, NULL, 0);
+	setKeyWidget(15, numberpadX, numberpadY, 3, 0, h, 0, 0, "+", 11, NULL, 0);
+	setKeyWidget(16, numberpadX, numberpadY, 0, h + 5, 2 * h + 5, h + 5, 0, "1", 11, NULL, 0);
+	setKeyWidget(17, numberpadX, numberpadY, 1, h + 5, 2 * h + 5, h + 5, 0, "2", 11, NULL, 0);
+	setKeyWidget(18, numberpadX, numberpadY, 2, h + 5, 2 * h + 5, h + 5, 0, "3", 11, NULL, 0);
+	setKeyWidget(19, numberpadX, numberpadY, 3, h + 5, 2 * h + 5, h + 5, 3, "-", 11, NULL, 0);
+	setKeyWidget(20, numberpadX, numberpadY, 0, 2 * h + 5, 3 * h + 5, 2 * h + 9, 0, "4", 11, NULL, 0);
+	setKeyWidget(21, numberpadX, numberpadY, 1, 2 * h + 5, 3 * h + 5, 2 * h + 9, 0, "5", 11, NULL, 0);
+	setKeyWidget(22, numberpadX, numberpadY, 2, 2 * h + 5, 3 * h + 5, 2 * h + 9, 0, "6", 11, NULL, 0);
+	setKeyWidget(23, numberpadX, numberpadY, 3, 2 * h + 5, 3 * h + 5, 2 * h + 9, 4, "*", 11, NULL, 0);
+	setKeyWidget(24, numberpadX, numberpadY, 0, 3 * h + 5, 4 * h + 5, 3 * h + 12, 0, "7", 11, NULL, 0);
+	setKeyWidget(25, numberpadX, numberpadY, 1, 3 * h + 5, 4 * h, 3 * h + 12, 0, "8", 11, NULL, 0);
+	setKeyWidget(26, numberpadX, numberpadY, 2, 3 * h + 5, 4 * h, 3 * h + 12, 0, "9", 11, NULL, 0);
+	setKeyWidget(27, numberpadX, numberpadY, 3, 3 * h + 5, 4 * h, 3 * h + 12, 3, "/", 11, NULL, 0);
+}
+void buildKeyGrid()
+{
+	buildKeyWidgets();
+	memset(keyGrid, -1, sizeof(keyGrid));
+	for (int k = 0; k < KEY_COUNT; k++)
+	{
+		KeyWidget *key = &keyWidgets[k];
+		int cx0 = key->x0 / KEY_CELL, cx1 = key->x1 / KEY_CELL;
+		int cy0 = key->y0 / KEY_CELL, cy1 = key->y1 / KEY_CELL;
+		for (int cy = cy0; cy <= cy1 && cy < KEY_GRID_ROWS; cy++)
+		{
+			for (int cx = cx0; cx <= cx1 && cx < KEY_GRID_COLS; cx++)
+			{
+				signed char *cell = keyGrid[cy][cx];
+				int s = 0;
+				while (s < KEY_CELL_SLOTS && cell[s] >= 0)
+				{
+					s++;
+				}
+				if (s < KEY_CELL_SLOTS)
+				{
+					cell[s] = k;
+				}
+			}
+		}
+	}
+	keyGridBuilt = true;
+}
+// Key whose rectangle contains (x, y), or -1. Where two rectangles share an
+// edge the key listed first wins.
+int keyAt(int x, int y)
+{
+	if (!keyGridBuilt)
+	{
+		buildKeyGrid();
+	}
+	if (x < 0 || y < 0 || x >= KEY_GRID_COLS * KEY_CELL || y >= KEY_GRID_ROWS * KEY_CELL)
+	{
+		return -1;
+	}
+	signed char *cell = keyGrid[y / KEY_CELL][x / KEY_CELL];
+	for (int s = 0; s < KEY_CELL_SLOTS && cell[s] >= 0; s++)
+	{
+		KeyWidget *key = &keyWidgets[cell[s]];
+		if (x >= key->x0 && x <= key->x1 && y >= key->y0 && y <= key->y1)
+		{
+			return cell[s];
+		}
+	}
+	return -1;
+}
+// Key under (mouseX, mouseY), looked up again only after the mouse has moved
+int keyUnderMouse()
+{
+	if (mouseX != hitMouseX || mouseY != hitMouseY)
+	{
+		hitKey = keyAt(mouseX, mouseY);
+		hitMouseX = mouseX;
+		hitMouseY = mouseY;
+	}
+	return hitKey;
+}
 void keyboardMap()
 {
 	if (showFloatingWindow == true && showKeyboard == true)
 	{
 		typeState == true;
 		counter = 0;
-		if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY && mouseY <= buttonY + buttonHeight)
+		int k = keyUnderMouse();
+		if (k == KEY_SHIFT)
 		{
-
 			funcType[selectedTextBox] = 3;
 		}
-		if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY && mouseY <= buttonY + buttonHeight)
-		{
-
-			const char *sqrtStr = "ln(";
-			strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-			indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-			cursorIndex[selectedTextBox] += 26;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY && mouseY <= buttonY + buttonHeight)
-		{
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = ')';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 8;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-
-		if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY + buttonHeight + 5 && mouseY <= buttonY + buttonHeight * 2 + 5)
+		else if (k > 0)
 		{
-
-			if (funcType[selectedTextBox] == 3)
+			KeyWidget *key = &keyWidgets[k];
+			const char *text = key->text;
+			int advance = key->advance;
+			if (funcType[selectedTextBox] == 3 && key->inverseText != NULL)
 			{
-				const char *sqrtStr = "acosec(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 75;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
+				text = key->inverseText;
+				advance = key->inverseAdvance;
 			}
-			else
+
+			int length = strlen(text);
+			if (indexNumber[selectedTextBox + 1] + length < MAX_TEXT_LENGTH)
 			{
-				const char *sqrtStr = "cosec(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 63;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
+				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], text);
+				indexNumber[selectedTextBox + 1] += length;
+				cursorIndex[selectedTextBox] += advance;
 				strcpy(func1[selectedTextBox], func[selectedTextBox]);
 			}
 		}
-		if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY + buttonHeight + 5 && mouseY <= buttonY + buttonHeight * 2 + 5)
+		if (k >= 0)
 		{
-			if (funcType[selectedTextBox] == 3)
-			{
-				const char *sqrtStr = "asec(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 52;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-			else
-			{
-				const char *sqrtStr = "sec(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 41;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-		}
-		if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY + buttonHeight + 5 && mouseY <= buttonY + buttonHeight * 2 + 5)
-		{
-
-			if (funcType[selectedTextBox] == 3)
-			{
-				const char *sqrtStr = "acot(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 50;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-			else
-			{
-				const char *sqrtStr = "cot(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 39;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-		}
-
-		if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY + buttonHeight * 2 + 9 && mouseY <= buttonY + buttonHeight * 3 + 5)
-		{
-
-			if (funcType[selectedTextBox] == 3)
-			{
-				const char *sqrtStr = "asin(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 48;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-			else
-			{
-				const char *sqrtStr = "sin(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 38;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-		}
-		if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY + buttonHeight * 2 + 9 && mouseY <= buttonY + buttonHeight * 3 + 5)
-		{
-
-			if (funcType[selectedTextBox] == 3)
-			{
-				const char *sqrtStr = "acos(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 52;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-			else
-			{
-				const char *sqrtStr = "cos(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 41;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-		}
-		if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY + buttonHeight * 2 + 9 && mouseY <= buttonY + buttonHeight * 3 + 5)
-		{
-			if (funcType[selectedTextBox] == 3)
-			{
-				const char *sqrtStr = "atan(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 50;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-			else
-			{
-				const char *sqrtStr = "tan(";
-				strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-				indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-				cursorIndex[selectedTextBox] += 39;
-				func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-				strcpy(func1[selectedTextBox], func[selectedTextBox]);
-			}
-		}
-
-		if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY + buttonHeight * 3 + 7 && mouseY <= buttonY + buttonHeight * 4 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = 'x';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY + buttonHeight * 3 + 10 && mouseY <= buttonY + buttonHeight * 4)
-		{
-
-			const char *sqrtStr = "pow(";
-			strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-			indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-			cursorIndex[selectedTextBox] += 50;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY + buttonHeight * 3 + 10 && mouseY <= buttonY + buttonHeight * 4)
-		{
-
-			const char *sqrtStr = "exp(";
-			strcpy(func[selectedTextBox] + indexNumber[selectedTextBox + 1], sqrtStr);
-			indexNumber[selectedTextBox + 1] += strlen(sqrtStr);
-			cursorIndex[selectedTextBox] += 45;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-
-		if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '0';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '.';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 7;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = ',';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 7;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '+';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '1';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '2';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '3';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '-';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '4';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '5';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = ' \0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '6';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = ' \0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '*';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = ' \0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4 + 5)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '7';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '8';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '9';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
-		}
-		if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4)
-		{
-
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '/';
-			indexNumber[selectedTextBox + 1]++;
-			cursorIndex[selectedTextBox] += 11;
-			func[selectedTextBox][indexNumber[selectedTextBox + 1]] = '\0';
-			strcpy(func1[selectedTextBox], func[selectedTextBox]);
+			parseFunction(selectedTextBox);
 		}
 	}
 }
 void highlightKeyboardButton()
 {
-	if (counter <= 7)
-	{
-		if (showFloatingWindow == true && showKeyboard == true)
-		{
-
-			if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY && mouseY <= buttonY + buttonHeight)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 1 + 5, buttonY, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY && mouseY <= buttonY + buttonHeight)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 2 + 5, buttonY, buttonWidth, buttonHeight);
-			}
-
-			if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY + buttonHeight + 5 && mouseY <= buttonY + buttonHeight * 2 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX, buttonY + buttonHeight + 5, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY + buttonHeight + 5 && mouseY <= buttonY + buttonHeight * 2 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 1 + 5, buttonY + buttonHeight + 5, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY + buttonHeight + 5 && mouseY <= buttonY + buttonHeight * 2 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 2 + 5, buttonY + buttonHeight + 5, buttonWidth, buttonHeight);
-			}
-
-			if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY + buttonHeight * 2 + 7 && mouseY <= buttonY + buttonHeight * 3 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX, buttonY + buttonHeight * 2 + 9, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY + buttonHeight * 2 + 7 && mouseY <= buttonY + buttonHeight * 3 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 1 + 5, buttonY + buttonHeight * 2 + 9, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY + buttonHeight * 2 + 7 && mouseY <= buttonY + buttonHeight * 3 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 2 + 5, buttonY + buttonHeight * 2 + 9, buttonWidth, buttonHeight);
-			}
-
-			if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY + buttonHeight * 3 + 7 && mouseY <= buttonY + buttonHeight * 4 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX, buttonY + buttonHeight * 3 + 12, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= buttonX + buttonWidth * 1 + 5 && mouseX <= buttonX + buttonWidth * 2 && mouseY >= buttonY + buttonHeight * 3 + 7 && mouseY <= buttonY + buttonHeight * 4)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 1 + 5, buttonY + buttonHeight * 3 + 12, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= buttonX + buttonWidth * 2 + 5 && mouseX <= buttonX + buttonWidth * 3 && mouseY >= buttonY + buttonHeight * 3 + 7 && mouseY <= buttonY + buttonHeight * 4)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX + buttonWidth * 2 + 5, buttonY + buttonHeight * 3 + 12, buttonWidth, buttonHeight);
-			}
-
-			if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX, numberpadY, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 1 + 5, numberpadY, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 2 + 5, numberpadY, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY && mouseY <= numberpadY + buttonHeight)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 3 + 5, numberpadY, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX, numberpadY + buttonHeight + 5, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 1 + 5, numberpadY + buttonHeight + 5, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 2 + 5, numberpadY + buttonHeight + 5, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY + buttonHeight + 5 && mouseY <= numberpadY + buttonHeight * 2 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 3 + 8, numberpadY + buttonHeight + 5, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX, numberpadY + buttonHeight * 2 + 9, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 1 + 5, numberpadY + buttonHeight * 2 + 9, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 2 + 5, numberpadY + buttonHeight * 2 + 9, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY + buttonHeight * 2 + 5 && mouseY <= numberpadY + buttonHeight * 3 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 3 + 5 + 4, numberpadY + buttonHeight * 2 + 9, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX && mouseX <= numberpadX + buttonWidth && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4 + 5)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX, numberpadY + buttonHeight * 3 + 12, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 1 + 5 && mouseX <= numberpadX + buttonWidth * 2 && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 1 + 5, numberpadY + buttonHeight * 3 + 12, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 2 + 5 && mouseX <= numberpadX + buttonWidth * 3 && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 2 + 5, numberpadY + buttonHeight * 3 + 12, buttonWidth, buttonHeight);
-			}
-			if (mouseX >= numberpadX + buttonWidth * 3 + 5 && mouseX <= numberpadX + buttonWidth * 4 && mouseY >= numberpadY + buttonHeight * 3 + 5 && mouseY <= numberpadY + buttonHeight * 4)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(numberpadX + buttonWidth * 3 + 8, numberpadY + buttonHeight * 3 + 12, buttonWidth, buttonHeight);
-			}
-		}
-	}
 	if (showFloatingWindow == true && showKeyboard == true)
 	{
-		if (mouseX >= buttonX && mouseX <= buttonX + buttonWidth && mouseY >= buttonY && mouseY <= buttonY + buttonHeight)
+		int k = keyUnderMouse();
+		// A clicked key flashes for a few frames; shift stays lit while hovered in an inverse-function box
+		if ((k > 0 && counter <= 7) || (k == KEY_SHIFT && funcType[selectedTextBox] == 3))
 		{
-			if (funcType[selectedTextBox] == 3)
-			{
-
-				iSetColor(255, 165, 0);
-				iRectangle(buttonX, buttonY, buttonWidth, buttonHeight);
-			}
+			iSetColor(255, 165, 0);
+			iRectangle(keyWidgets[k].boxX, keyWidgets[k].boxY, buttonWidth, buttonHeight);
 		}
 	}
 }
@@ -1483,51 +1847,51 @@ void warning()
 		iText(60, windowHeight - 30 - textBoxPositions[selectedTextBox] - offsetY1, "No functions selected!", GLUT_BITMAP_HELVETICA_12, 0.0);
 	}
 }
-void readSin(int i, double &a, double &b, double &c, double &d, double &e)
+void readSin(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * sin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf sin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * sin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf sin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = sin(mx - c) type equation
 		b = 0; // To make it y = sin(mx + (-c))
 		funcSpec[i][1][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf sin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * sin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf sin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = sin(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sin(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf sin(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf sin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * sin(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sin(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf sin(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf sin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * sin(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = sin(mx) type equation
 		funcSpec[i][1][1] = 1;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sin(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf sin(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf sin(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * sin(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sin(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf sin(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf sin(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * sin(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = sin(mx - c) type equation
 		b = 0; // To make it y = sin(mx + (-c))
 		funcSpec[i][1][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sin(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf sin(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf sin(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * sin(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sin(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf sin(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf sin(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * sin(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = sin(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * sin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = sin(mx - c) type equation
 		b = 0; // To make it y = sin(mx + (-c))
 		funcSpec[i][1][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * sin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = sin(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sin(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf sin(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf sin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * sin(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sin(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf sin(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf sin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * sin(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = sin(mx) type equation
 		funcSpec[i][1][1] = 1;
@@ -1539,52 +1903,52 @@ void readSin(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readCos(int i, double &a, double &b, double &c, double &d, double &e)
+void readCos(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * cos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf cos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * cos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf cos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 
 	{
 		// For y = cos(mx - c) type equation
 		b = 0; // To make it y = cos(mx + (-c))
 		funcSpec[i][1][2] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf cos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf cos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = cos(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][2] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cos(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf cos(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf cos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * cos(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cos(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf cos(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf cos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * cos(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = cos(mx) type equation
 		funcSpec[i][1][2] = 1;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cos(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf cos(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf cos(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * cos(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cos(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf cos(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf cos(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * cos(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = cos(mx - c) type equation
 		b = 0; // To make it y = cos(mx + (-c))
 		funcSpec[i][1][2] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cos(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf cos(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf cos(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * cos(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cos(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf cos(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf cos(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * cos(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = cos(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][2] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * cos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = cos(mx - c) type equation
 		b = 0; // To make it y = cos(mx + (-c))
 		funcSpec[i][1][2] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * cos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = cos(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][2] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cos(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf cos(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf cos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * cos(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cos(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf cos(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf cos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * cos(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = cos(mx) type equation
 		funcSpec[i][1][2] = 1;
@@ -1596,51 +1960,51 @@ void readCos(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readTan(int i, double &a, double &b, double &c, double &d, double &e)
+void readTan(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * tan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf tan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * tan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf tan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = tan(mx - c) type equation
 		b = 0; // To make it y = tan(mx + (-c))
 		funcSpec[i][1][3] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * tan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf tan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * tan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf tan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = tan(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][3] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * tan(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf tan(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf tan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * tan(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * tan(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf tan(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf tan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * tan(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = tan(mx) type equation
 		funcSpec[i][1][3] = 1;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * tan(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf tan(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf tan(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * tan(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * tan(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf tan(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf tan(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * tan(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = tan(mx - c) type equation
 		b = 0; // To make it y = tan(mx + (-c))
 		funcSpec[i][1][3] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * tan(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf tan(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf tan(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * tan(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * tan(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf tan(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf tan(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * tan(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = tan(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][3] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * tan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = tan(mx - c) type equation
 		b = 0; // To make it y = tan(mx + (-c))
 		funcSpec[i][1][3] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * tan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = tan(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][3] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * tan(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf tan(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf tan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * tan(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * tan(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf tan(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf tan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * tan(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = tan(mx) type equation
 		funcSpec[i][1][3] = 1;
@@ -1652,51 +2016,51 @@ void readTan(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readCot(int i, double &a, double &b, double &c, double &d, double &e)
+void readCot(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * cot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf cot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * cot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf cot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = cot(mx - c) type equation
 		b = 0; // To make it y = cot(mx + (-c))
 		funcSpec[i][1][4] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf cot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf cot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = cot(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][4] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cot(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf cot(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf cot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * cot(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cot(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf cot(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf cot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * cot(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = cot(mx) type equation
 		funcSpec[i][1][4] = 1;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cot(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf cot(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf cot(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * cot(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cot(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf cot(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf cot(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * cot(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = cot(mx - c) type equation
 		b = 0; // To make it y = cot(mx + (-c))
 		funcSpec[i][1][4] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cot(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf cot(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf cot(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * cot(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cot(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf cot(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf cot(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * cot(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = cot(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][4] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * cot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = cot(mx - c) type equation
 		b = 0; // To make it y = cot(mx + (-c))
 		funcSpec[i][1][4] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * cot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = cot(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][4] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cot(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf cot(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf cot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * cot(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cot(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf cot(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf cot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * cot(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = cot(mx) type equation
 		funcSpec[i][1][4] = 1;
@@ -1708,51 +2072,51 @@ void readCot(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readCosec(int i, double &a, double &b, double &c, double &d, double &e)
+void readCosec(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf cosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * cosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf cosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = cosec(mx - c) type equation
 		b = 0; // To make it y = cosec(mx + (-c))
 		funcSpec[i][1][5] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf cosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf cosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = cosec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][5] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf cosec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf cosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cosec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf cosec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf cosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * cosec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = cosec(mx) type equation
 		funcSpec[i][1][5] = 1;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf cosec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf cosec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cosec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf cosec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf cosec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * cosec(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = cosec(mx - c) type equation
 		b = 0; // To make it y = cosec(mx + (-c))
 		funcSpec[i][1][5] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf cosec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf cosec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cosec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf cosec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf cosec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * cosec(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = cosec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][5] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * cosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = cosec(mx - c) type equation
 		b = 0; // To make it y = cosec(mx + (-c))
 		funcSpec[i][1][5] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * cosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = cosec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][5] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * cosec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf cosec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf cosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * cosec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * cosec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf cosec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf cosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * cosec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = cosec(mx) type equation
 		funcSpec[i][1][5] = 1;
@@ -1764,51 +2128,51 @@ void readCosec(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readSec(int i, double &a, double &b, double &c, double &d, double &e)
+void readSec(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * sec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf sec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * sec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf sec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = sec(mx - c) type equation
 		b = 0; // To make it y = sec(mx + (-c))
 		funcSpec[i][1][6] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf sec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * sec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf sec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = sec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][6] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf sec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf sec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * sec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf sec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf sec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * sec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = sec(mx) type equation
 		funcSpec[i][1][6] = 1;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf sec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf sec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * sec(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf sec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf sec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * sec(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = sec(mx - c) type equation
 		b = 0; // To make it y = sec(mx + (-c))
 		funcSpec[i][1][6] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf sec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf sec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * sec(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf sec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf sec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * sec(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = sec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][6] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * sec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = sec(mx - c) type equation
 		b = 0; // To make it y = sec(mx + (-c))
 		funcSpec[i][1][6] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * sec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = sec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][1][6] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * sec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf sec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf sec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * sec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * sec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf sec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf sec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * sec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = sec(mx) type equation
 		funcSpec[i][1][6] = 1;
@@ -1820,52 +2184,52 @@ void readSec(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readASin(int i, double &a, double &b, double &c, double &d, double &e)
+void readASin(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * asin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf asin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * asin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf asin(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = asin(mx - c) type equation
 		b = 0; // To make it y = asin(mx + (-c))
 		funcSpec[i][2][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf asin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * asin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf asin(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = asin(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asin(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf asin(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf asin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * asin(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asin(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf asin(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf asin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * asin(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = asin(mx) type equation
 		funcSpec[i][2][1] = 1;
 
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asin(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf asin(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf asin(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * asin(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asin(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf asin(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf asin(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * asin(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = asin(mx - c) type equation
 		b = 0; // To make it y = asin(mx + (-c))
 		funcSpec[i][2][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asin(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf asin(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf asin(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * asin(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asin(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf asin(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf asin(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * asin(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = asin(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * asin(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = asin(mx - c) type equation
 		b = 0; // To make it y = asin(mx + (-c))
 		funcSpec[i][2][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * asin(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = asin(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][1] = 1;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asin(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf asin(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf asin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * asin(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asin(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf asin(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf asin(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * asin(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = asin(mx) type equation
 		funcSpec[i][2][1] = 1;
@@ -1877,51 +2241,51 @@ void readASin(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readACos(int i, double &a, double &b, double &c, double &d, double &e)
+void readACos(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * acos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf acos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * acos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf acos(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = acos(mx - c) type equation
 		b = 0; // To make it y = acos(mx + (-c))
 		funcSpec[i][2][2] = 2;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf acos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf acos(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = acos(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][2] = 2;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acos(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf acos(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf acos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * acos(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acos(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf acos(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf acos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * acos(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = acos(mx) type equation
 		funcSpec[i][2][2] = 2;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acos(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf acos(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf acos(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * acos(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acos(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf acos(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf acos(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * acos(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = acos(mx - c) type equation
 		b = 0; // To make it y = acos(mx + (-c))
 		funcSpec[i][2][2] = 2;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acos(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf acos(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf acos(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * acos(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acos(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf acos(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf acos(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * acos(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = acos(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][2] = 2;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * acos(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = acos(mx - c) type equation
 		b = 0; // To make it y = acos(mx + (-c))
 		funcSpec[i][2][2] = 2;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * acos(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = acos(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][2] = 2;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acos(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf acos(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf acos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * acos(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acos(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf acos(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf acos(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * acos(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = acos(mx) type equation
 		funcSpec[i][2][2] = 2;
@@ -1933,51 +2297,51 @@ void readACos(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readATan(int i, double &a, double &b, double &c, double &d, double &e)
+void readATan(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * atan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf atan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * atan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf atan(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = atan(mx - c) type equation
 		b = 0; // To make it y = atan(mx + (-c))
 		funcSpec[i][2][3] = 3;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * atan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf atan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * atan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf atan(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = atan(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][3] = 3;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * atan(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf atan(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf atan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * atan(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * atan(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf atan(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf atan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * atan(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = atan(mx) type equation
 		funcSpec[i][2][3] = 3;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * atan(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf atan(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf atan(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * atan(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * atan(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf atan(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf atan(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * atan(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = atan(mx - c) type equation
 		b = 0; // To make it y = atan(mx + (-c))
 		funcSpec[i][2][3] = 3;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * atan(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf atan(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf atan(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * atan(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * atan(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf atan(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf atan(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * atan(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = atan(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][3] = 3;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * atan(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = atan(mx - c) type equation
 		b = 0; // To make it y = atan(mx + (-c))
 		funcSpec[i][2][3] = 3;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * atan(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = atan(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][3] = 3;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * atan(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf atan(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf atan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * atan(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * atan(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf atan(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf atan(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * atan(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = atan(mx) type equation
 		funcSpec[i][2][3] = 3;
@@ -1989,51 +2353,51 @@ void readATan(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readACot(int i, double &a, double &b, double &c, double &d, double &e)
+void readACot(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * acot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf acot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * acot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf acot(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = acot(mx - c) type equation
 		b = 0; // To make it y = acot(mx + (-c))
 		funcSpec[i][2][4] = 4;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf acot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf acot(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = acot(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][4] = 4;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acot(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf acot(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf acot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * acot(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acot(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf acot(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf acot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * acot(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = acot(mx) type equation
 		funcSpec[i][2][4] = 4;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acot(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf acot(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf acot(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * acot(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acot(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf acot(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf acot(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * acot(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = acot(mx - c) type equation
 		b = 0; // To make it y = acot(mx + (-c))
 		funcSpec[i][2][4] = 4;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acot(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf acot(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf acot(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * acot(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acot(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf acot(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf acot(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * acot(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = acot(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][4] = 4;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * acot(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = acot(mx - c) type equation
 		b = 0; // To make it y = acot(mx + (-c))
 		funcSpec[i][2][4] = 4;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * acot(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = acot(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][4] = 4;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acot(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf acot(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf acot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * acot(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acot(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf acot(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf acot(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * acot(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = acot(mx) type equation
 		funcSpec[i][2][4] = 4;
@@ -2045,51 +2409,51 @@ void readACot(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readACosec(int i, double &a, double &b, double &c, double &d, double &e)
+void readACosec(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf acosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * acosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf acosec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = acosec(mx - c) type equation
 		b = 0; // To make it y = acosec(mx + (-c))
 		funcSpec[i][2][5] = 5;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf acosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf acosec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = acosec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][5] = 5;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf acosec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf acosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acosec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf acosec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf acosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * acosec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = acosec(mx) type equation
 		funcSpec[i][2][5] = 5;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf acosec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf acosec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acosec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf acosec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf acosec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * acosec(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = acosec(mx - c) type equation
 		b = 0; // To make it y = acosec(mx + (-c))
 		funcSpec[i][2][5] = 5;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf acosec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf acosec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acosec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf acosec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf acosec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * acosec(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = acosec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][5] = 5;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * acosec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = acosec(mx - c) type equation
 		b = 0; // To make it y = acosec(mx + (-c))
 		funcSpec[i][2][5] = 5;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * acosec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = acosec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][5] = 5;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * acosec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf acosec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf acosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * acosec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * acosec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf acosec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf acosec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * acosec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = acosec(mx) type equation
 		funcSpec[i][2][5] = 5;
@@ -2101,51 +2465,51 @@ void readACosec(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readASec(int i, double &a, double &b, double &c, double &d, double &e)
+void readASec(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * asec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf asec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	if ((sscanf(text, "f(x) = %lf * asec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf asec(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = asec(mx - c) type equation
 		b = 0; // To make it y = asec(mx + (-c))
 		funcSpec[i][2][6] = 6;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf asec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * asec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf asec(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = asec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][6] = 6;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf asec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf asec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * asec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asec(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf asec(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf asec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * asec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = asec(mx) type equation
 		funcSpec[i][2][6] = 6;
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf asec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf asec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(func[i], "f(x) = %lf * asec(%lfx - %lf)", &d, &a, &c) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asec(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf asec(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf asec(%lfx - %lf)", &d, &a, &c) == 3 || (sscanf(text, "f(x) = %lf * asec(%lfx - %lf)", &d, &a, &c) == 3))
 	{
 		// For y = asec(mx - c) type equation
 		b = 0; // To make it y = asec(mx + (-c))
 		funcSpec[i][2][6] = 6;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf asec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf asec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(func[i], "f(x) = %lf * asec(%lfx + %lf)", &d, &a, &b) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asec(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf asec(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf asec(%lfx + %lf)", &d, &a, &b) == 3 || (sscanf(text, "f(x) = %lf * asec(%lfx + %lf)", &d, &a, &b) == 3))
 	{
 		// For y = asec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][6] = 6;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || (sscanf(text, "f(x) = %lf * asec(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4))
 	{
 		// For y = asec(mx - c) type equation
 		b = 0; // To make it y = asec(mx + (-c))
 		funcSpec[i][2][6] = 6;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(func[i], "f(x) = %lf * asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
+	else if ((sscanf(text, "f(x) = %lf * asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || (sscanf(text, "f(x) = %lf * asec(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4))
 	{
 		// For y = asec(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 		funcSpec[i][2][6] = 6;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * asec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf asec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf asec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(func[i], "f(x) = %lf * asec(%lfx)+ %lf", &d, &a, &e) == 3))
+	else if ((sscanf(text, "f(x) = %lf * asec(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf asec(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf asec(%lfx)+ %lf", &d, &a, &e) == 3 || (sscanf(text, "f(x) = %lf * asec(%lfx)+ %lf", &d, &a, &e) == 3))
 	{
 		// For y = asec(mx) type equation
 		funcSpec[i][2][6] = 6;
@@ -2157,67 +2521,67 @@ void readASec(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readExp(int i, double &a, double &b, double &c, double &d, double &e)
+void readExp(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if ((sscanf(func[i], "f(x) = %lf * e^(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(func[i], "f(x) = %lf e^(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf * pow(e, %lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf pow(e, %lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4)
+	if ((sscanf(text, "f(x) = %lf * e^(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4) || sscanf(text, "f(x) = %lf e^(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf * pow(e, %lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf pow(e, %lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4)
 	{
 		// For y = e^(mx - c) type equation
 		b = 0; // To make it y = e^(mx + (-c))
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * e^(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(func[i], "f(x) = %lf e^(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf * pow(e, %lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf pow(e, %lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4)
+	else if ((sscanf(text, "f(x) = %lf * e^(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4) || sscanf(text, "f(x) = %lf e^(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf * pow(e, %lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf pow(e, %lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4)
 	{
 		// For y = e^(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * e^(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf  e^(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf * pow(e, %lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf pow(e, %lfx)+ (%lf)", &d, &a, &e) == 3)
+	else if ((sscanf(text, "f(x) = %lf * e^(%lfx)+ (%lf)", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf  e^(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf * pow(e, %lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf pow(e, %lfx)+ (%lf)", &d, &a, &e) == 3)
 	{
 		// For y = e^(mx) type equation
 		b = 0;
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * e^(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(func[i], "f(x) = %lf e^(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf * pow(e, %lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf pow(e, %lfx - %lf)", &d, &a, &c) == 3)
+	else if ((sscanf(text, "f(x) = %lf * e^(%lfx - %lf)", &d, &a, &c) == 3) || sscanf(text, "f(x) = %lf e^(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf * pow(e, %lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf pow(e, %lfx - %lf)", &d, &a, &c) == 3)
 	{
 		// For y = e^(mx - c) type equation
 		b = 0; // To make it y = e^(mx + (-c))
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * e^(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(func[i], "f(x) = %lf e^(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf * pow(e, %lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf pow(e, %lfx + %lf)", &d, &a, &b) == 3)
+	else if ((sscanf(text, "f(x) = %lf * e^(%lfx + %lf)", &d, &a, &b) == 3) || sscanf(text, "f(x) = %lf e^(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf * pow(e, %lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf pow(e, %lfx + %lf)", &d, &a, &b) == 3)
 	{
 		// For y = e^(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 	}
-	else if ((sscanf(func[i], "f(x) = %lf * e^(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(func[i], "f(x) = %lf e^(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf * pow(e, %lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf pow(e, %lfx)+ %lf", &d, &a, &e) == 3)
+	else if ((sscanf(text, "f(x) = %lf * e^(%lfx)+ %lf", &d, &a, &e) == 3) || sscanf(text, "f(x) = %lf e^(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf * pow(e, %lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf pow(e, %lfx)+ %lf", &d, &a, &e) == 3)
 	{
 		// For y = e^(mx) type equation
 		b = 0;
 	}
 }
-void readLog(int i, double &a, double &b, double &c, double &d, double &e, double &base)
+void readLog(int i, const char *text, double &a, double &b, double &c, double &d, double &e, double &base)
 {
-	if (sscanf(func[i], "f(x) = %lf * log(%lfx - %lf, %lf)+ (%lf)", &d, &a, &c, &base, &e) == 5 || sscanf(func[i], "f(x) = %lf log(%lfx - %lf, %lf)+ (%lf)", &d, &a, &c, &base, &e) == 5 || sscanf(func[i], "f(x) = %lf log(%lfx - %lf, %lf)+ %lf", &d, &a, &c, &base, &e) == 5 || sscanf(func[i], "f(x) = %lf * log(%lfx - %lf, %lf)+ %lf", &d, &a, &c, &base, &e) == 5)
+	if (sscanf(text, "f(x) = %lf * log(%lfx - %lf, %lf)+ (%lf)", &d, &a, &c, &base, &e) == 5 || sscanf(text, "f(x) = %lf log(%lfx - %lf, %lf)+ (%lf)", &d, &a, &c, &base, &e) == 5 || sscanf(text, "f(x) = %lf log(%lfx - %lf, %lf)+ %lf", &d, &a, &c, &base, &e) == 5 || sscanf(text, "f(x) = %lf * log(%lfx - %lf, %lf)+ %lf", &d, &a, &c, &base, &e) == 5)
 	{
 		// For y = log(mx - c) type equation
 		b = 0; // To make it y = log(mx + (-c))
 	}
-	else if (sscanf(func[i], "f(x) = %lf * log(%lfx + %lf, %lf)+ (%lf)", &d, &a, &b, &base, &e) == 5 || sscanf(func[i], "f(x) = %lf log(%lfx + %lf, %lf)+ (%lf)", &d, &a, &b, &base, &e) == 5 || sscanf(func[i], "f(x) = %lf log(%lfx + %lf, %lf)+ %lf", &d, &a, &b, &base, &e) == 5 || sscanf(func[i], "f(x) = %lf * log(%lfx + %lf, %lf)+ %lf", &d, &a, &b, &base, &e) == 5)
+	else if (sscanf(text, "f(x) = %lf * log(%lfx + %lf, %lf)+ (%lf)", &d, &a, &b, &base, &e) == 5 || sscanf(text, "f(x) = %lf log(%lfx + %lf, %lf)+ (%lf)", &d, &a, &b, &base, &e) == 5 || sscanf(text, "f(x) = %lf log(%lfx + %lf, %lf)+ %lf", &d, &a, &b, &base, &e) == 5 || sscanf(text, "f(x) = %lf * log(%lfx + %lf, %lf)+ %lf", &d, &a, &b, &base, &e) == 5)
 	{
 		// For y = log(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 	}
-	else if (sscanf(func[i], "f(x) = %lf * log(%lfx, %lf)+ (%lf)", &d, &a, &base, &e) == 4 || sscanf(func[i], "f(x) = %lf log(%lfx, %lf)+ (%lf)", &d, &a, &base, &e) == 4 || sscanf(func[i], "f(x) = %lf log(%lfx, %lf)+ %lf", &d, &a, &base, &e) == 4 || sscanf(func[i], "f(x) = %lf * log(%lfx, %lf)+ %lf", &d, &a, &base, &e) == 4)
+	else if (sscanf(text, "f(x) = %lf * log(%lfx, %lf)+ (%lf)", &d, &a, &base, &e) == 4 || sscanf(text, "f(x) = %lf log(%lfx, %lf)+ (%lf)", &d, &a, &base, &e) == 4 || sscanf(text, "f(x) = %lf log(%lfx, %lf)+ %lf", &d, &a, &base, &e) == 4 || sscanf(text, "f(x) = %lf * log(%lfx, %lf)+ %lf", &d, &a, &base, &e) == 4)
 	{
 		// For y = log(mx) type equation
 		b = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lf * log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4 || sscanf(func[i], "f(x) = %lf log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4 || sscanf(func[i], "f(x) = %lf log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4 || sscanf(func[i], "f(x) = %lf * log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4)
+	else if (sscanf(text, "f(x) = %lf * log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4 || sscanf(text, "f(x) = %lf log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4 || sscanf(text, "f(x) = %lf log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4 || sscanf(text, "f(x) = %lf * log(%lfx - %lf, %lf)", &d, &a, &c, &base) == 4)
 	{
 		// For y = log(mx - c) type equation
 		b = 0; // To make it y = log(mx + (-c))
 	}
-	else if (sscanf(func[i], "f(x) = %lf * log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4 || sscanf(func[i], "f(x) = %lf log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4 || sscanf(func[i], "f(x) = %lf log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4 || sscanf(func[i], "f(x) = %lf * log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4)
+	else if (sscanf(text, "f(x) = %lf * log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4 || sscanf(text, "f(x) = %lf log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4 || sscanf(text, "f(x) = %lf log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4 || sscanf(text, "f(x) = %lf * log(%lfx + %lf, %lf)", &d, &a, &b, &base) == 4)
 	{
 		// For y = log(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 	}
-	else if (sscanf(func[i], "f(x) = %lf * log(%lfx, %lf)", &d, &a, &base) == 3 || sscanf(func[i], "f(x) = %lf log(%lfx, %lf)", &d, &a, &base) == 3 || sscanf(func[i], "f(x) = %lf log(%lfx, %lf)", &d, &a, &base) == 3 || sscanf(func[i], "f(x) = %lf * log(%lfx, %lf)", &d, &a, &base) == 3)
+	else if (sscanf(text, "f(x) = %lf * log(%lfx, %lf)", &d, &a, &base) == 3 || sscanf(text, "f(x) = %lf log(%lfx, %lf)", &d, &a, &base) == 3 || sscanf(text, "f(x) = %lf log(%lfx, %lf)", &d, &a, &base) == 3 || sscanf(text, "f(x) = %lf * log(%lfx, %lf)", &d, &a, &base) == 3)
 	{
 		// For y = log(mx) type equation
 		b = 0;
@@ -2228,34 +2592,34 @@ void readLog(int i, double &a, double &b, double &c, double &d, double &e, doubl
 		drawState[i] = 3;
 	}
 }
-void readLn(int i, double &a, double &b, double &c, double &d, double &e)
+void readLn(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if (sscanf(func[i], "f(x) = %lf * ln(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf ln(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf ln(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(func[i], "f(x) = %lf * ln(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4)
+	if (sscanf(text, "f(x) = %lf * ln(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf ln(%lfx - %lf)+ (%lf)", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf ln(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4 || sscanf(text, "f(x) = %lf * ln(%lfx - %lf)+ %lf", &d, &a, &c, &e) == 4)
 	{
 		// For y = ln(mx - c) type equation
 		b = 0; // To make it y = ln(mx + (-c))
 	}
-	else if (sscanf(func[i], "f(x) = %lf * ln(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf ln(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf ln(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(func[i], "f(x) = %lf * ln(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4)
+	else if (sscanf(text, "f(x) = %lf * ln(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf ln(%lfx + %lf)+ (%lf)", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf ln(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4 || sscanf(text, "f(x) = %lf * ln(%lfx + %lf)+ %lf", &d, &a, &b, &e) == 4)
 	{
 		// For y = ln(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 	}
-	else if (sscanf(func[i], "f(x) = %lf * ln(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf * ln(%lfx)+ %lf", &d, &a, &e) == 3)
+	else if (sscanf(text, "f(x) = %lf * ln(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf ln(%lfx)+ (%lf)", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf * ln(%lfx)+ %lf", &d, &a, &e) == 3)
 	{
 		// For y = ln(mx) type equation
 		b = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lf * ln(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(func[i], "f(x) = %lf * ln(%lfx - %lf)", &d, &a, &c) == 3)
+	else if (sscanf(text, "f(x) = %lf * ln(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf ln(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf ln(%lfx - %lf)", &d, &a, &c) == 3 || sscanf(text, "f(x) = %lf * ln(%lfx - %lf)", &d, &a, &c) == 3)
 	{
 		// For y = ln(mx - c) type equation
 		b = 0; // To make it y = ln(mx + (-c))
 	}
-	else if (sscanf(func[i], "f(x) = %lf * ln(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(func[i], "f(x) = %lf * ln(%lfx + %lf)", &d, &a, &b) == 3)
+	else if (sscanf(text, "f(x) = %lf * ln(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf ln(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf ln(%lfx + %lf)", &d, &a, &b) == 3 || sscanf(text, "f(x) = %lf * ln(%lfx + %lf)", &d, &a, &b) == 3)
 	{
 		// For y = ln(mx + c) type equation
 		// Do nothing as coefficients are already assigned
 	}
-	else if (sscanf(func[i], "f(x) = %lf * ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(func[i], "f(x) = %lf * ln(%lfx)+ %lf", &d, &a, &e) == 3)
+	else if (sscanf(text, "f(x) = %lf * ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf ln(%lfx)+ %lf", &d, &a, &e) == 3 || sscanf(text, "f(x) = %lf * ln(%lfx)+ %lf", &d, &a, &e) == 3)
 	{
 		// For y = ln(mx) type equation
 		b = 0;
@@ -2266,21 +2630,21 @@ void readLn(int i, double &a, double &b, double &c, double &d, double &e)
 		drawState[i] = 3;
 	}
 }
-void readQuadratic(int i, double &a, double &b, double &c)
+void readQuadratic(int i, const char *text, double &a, double &b, double &c)
 {
-	if (sscanf(func[i], "f(x) = %lfx^2 + %lfx + %lf", &a, &b, &c) == 3 || sscanf(func[i], "f(x) = %lf pow(x,2) + %lfx + %lf", &a, &b, &c) == 3)
+	if (sscanf(text, "f(x) = %lfx^2 + %lfx + %lf", &a, &b, &c) == 3 || sscanf(text, "f(x) = %lf pow(x,2) + %lfx + %lf", &a, &b, &c) == 3)
 	{
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^2 + %lfx ", &a, &b) == 2 || sscanf(func[i], "f(x) = %lf pow(x,2) + %lfx ", &a, &b) == 2)
+	else if (sscanf(text, "f(x) = %lfx^2 + %lfx ", &a, &b) == 2 || sscanf(text, "f(x) = %lf pow(x,2) + %lfx ", &a, &b) == 2)
 	{
 		c = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^2 + %lf", &a, &c) == 2 || sscanf(func[i], "f(x) = %lf pow(x,2) + %lf", &a, &c) == 2)
+	else if (sscanf(text, "f(x) = %lfx^2 + %lf", &a, &c) == 2 || sscanf(text, "f(x) = %lf pow(x,2) + %lf", &a, &c) == 2)
 	{
 
 		b = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^2 ", &a) == 1 || sscanf(func[i], "f(x) = %lf pow(x,2) ", &a) == 1)
+	else if (sscanf(text, "f(x) = %lfx^2 ", &a) == 1 || sscanf(text, "f(x) = %lf pow(x,2) ", &a) == 1)
 	{
 
 		b = 0;
@@ -2292,26 +2656,26 @@ void readQuadratic(int i, double &a, double &b, double &c)
 		drawState[i] = 3;
 	}
 }
-void readCubic(int i, double &a, double &b, double &c, double &d)
+void readCubic(int i, const char *text, double &a, double &b, double &c, double &d)
 {
-	if (sscanf(func[i], "f(x) = %lfx^3 + %lfx^2 + %lfx + %lf", &a, &b, &c, &d) == 4 || sscanf(func[i], "f(x) = %lf pow(x,3) + %lf pow(x,2) + %lfx + %lf", &a, &b, &c, &d) == 4)
+	if (sscanf(text, "f(x) = %lfx^3 + %lfx^2 + %lfx + %lf", &a, &b, &c, &d) == 4 || sscanf(text, "f(x) = %lf pow(x,3) + %lf pow(x,2) + %lfx + %lf", &a, &b, &c, &d) == 4)
 	{
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^3 + %lfx^2 + %lfx ", &a, &b, &c) == 3 || sscanf(func[i], "f(x) = %lf pow(x,3) + %lf pow(x,2) + %lfx ", &a, &b, &c) == 3)
+	else if (sscanf(text, "f(x) = %lfx^3 + %lfx^2 + %lfx ", &a, &b, &c) == 3 || sscanf(text, "f(x) = %lf pow(x,3) + %lf pow(x,2) + %lfx ", &a, &b, &c) == 3)
 	{
 		d = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^3 + %lfx^2 ", &a, &b) == 2 || sscanf(func[i], "f(x) = %lf pow(x,3) + %lf pow(x,2) ", &a, &b) == 2)
+	else if (sscanf(text, "f(x) = %lfx^3 + %lfx^2 ", &a, &b) == 2 || sscanf(text, "f(x) = %lf pow(x,3) + %lf pow(x,2) ", &a, &b) == 2)
 	{
 		c = 0;
 		d = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^3 + %lf", &a, &d) == 2 || sscanf(func[i], "f(x) = %lf pow(x,3) + %lf", &a, &d) == 2)
+	else if (sscanf(text, "f(x) = %lfx^3 + %lf", &a, &d) == 2 || sscanf(text, "f(x) = %lf pow(x,3) + %lf", &a, &d) == 2)
 	{
 		b = 0;
 		c = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^3 ", &a) == 1 || sscanf(func[i], "f(x) = %lf pow(x,3) ", &a) == 1)
+	else if (sscanf(text, "f(x) = %lfx^3 ", &a) == 1 || sscanf(text, "f(x) = %lf pow(x,3) ", &a) == 1)
 	{
 		b = 0;
 		c = 0;
@@ -2323,33 +2687,33 @@ void readCubic(int i, double &a, double &b, double &c, double &d)
 		drawState[i] = 3;
 	}
 }
-void readTetra(int i, double &a, double &b, double &c, double &d, double &e)
+void readTetra(int i, const char *text, double &a, double &b, double &c, double &d, double &e)
 {
-	if (sscanf(func[i], "f(x) = %lfx^4 + %lfx^3 + %lfx^2 + %lfx + %lf", &a, &b, &c, &d, &e) == 5 || sscanf(func[i], "f(x) = %lf pow(x,4) + %lf pow(x,3) + %lf pow(x,2) + %lfx + %lf", &a, &b, &c, &d, &e) == 5)
+	if (sscanf(text, "f(x) = %lfx^4 + %lfx^3 + %lfx^2 + %lfx + %lf", &a, &b, &c, &d, &e) == 5 || sscanf(text, "f(x) = %lf pow(x,4) + %lf pow(x,3) + %lf pow(x,2) + %lfx + %lf", &a, &b, &c, &d, &e) == 5)
 	{
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^4 + %lfx^3 + %lfx^2 + %lfx ", &a, &b, &c, &d) == 4 || sscanf(func[i], "f(x) = %lf pow(x,4) + %lf pow(x,3) + %lf pow(x,2) + %lfx ", &a, &b, &c, &d) == 4)
+	else if (sscanf(text, "f(x) = %lfx^4 + %lfx^3 + %lfx^2 + %lfx ", &a, &b, &c, &d) == 4 || sscanf(text, "f(x) = %lf pow(x,4) + %lf pow(x,3) + %lf pow(x,2) + %lfx ", &a, &b, &c, &d) == 4)
 	{
 		e = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^4 + %lfx^3 + %lfx^2 ", &a, &b, &c) == 3 || sscanf(func[i], "f(x) = %lf pow(x,4) + %lf pow(x,3) + %lf pow(x,2) ", &a, &b, &c) == 3)
+	else if (sscanf(text, "f(x) = %lfx^4 + %lfx^3 + %lfx^2 ", &a, &b, &c) == 3 || sscanf(text, "f(x) = %lf pow(x,4) + %lf pow(x,3) + %lf pow(x,2) ", &a, &b, &c) == 3)
 	{
 		d = 0;
 		e = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^4 + %lfx^3 ", &a, &b) == 2 || sscanf(func[i], "f(x) = %lf pow(x,4) + %lf pow(x,3) ", &a, &b) == 2)
+	else if (sscanf(text, "f(x) = %lfx^4 + %lfx^3 ", &a, &b) == 2 || sscanf(text, "f(x) = %lf pow(x,4) + %lf pow(x,3) ", &a, &b) == 2)
 	{
 		c = 0;
 		d = 0;
 		e = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^4 + %lf", &a, &e) == 2 || sscanf(func[i], "f(x) = %lf pow(x,4) + %lf", &a, &e) == 2)
+	else if (sscanf(text, "f(x) = %lfx^4 + %lf", &a, &e) == 2 || sscanf(text, "f(x) = %lf pow(x,4) + %lf", &a, &e) == 2)
 	{
 		b = 0;
 		c = 0;
 		d = 0;
 	}
-	else if (sscanf(func[i], "f(x) = %lfx^4 ", &a) == 1 || sscanf(func[i], "f(x) = %lf pow(x,4) ", &a) == 1)
+	else if (sscanf(text, "f(x) = %lfx^4 ", &a) == 1 || sscanf(text, "f(x) = %lf pow(x,4) ", &a) == 1)
 	{
 		b = 0;
 		c = 0;
@@ -2363,632 +2727,1100 @@ void readTetra(int i, double &a, double &b, double &c, double &d, double &e)
 	}
 }
 
-void drawFunc()
+bool isReservedName(const char *word, int len)
 {
-
-	for (int i = 1; i < textBoxCount; ++i)
+	static const char *reserved[] = {"f", "x", "e", "pow", "sin", "cos", "tan", "cot", "cosec", "sec", "asin", "acos", "atan", "acot", "acosec", "asec", "log", "ln"};
+	for (int k = 0; k < (int)(sizeof(reserved) / sizeof(reserved[0])); k++)
 	{
-		if (strlen(func[i]) <= 7 || funcType[i] == 0 || showCurve[i] == 1)
+		if ((int)strlen(reserved[k]) == len && strncmp(reserved[k], word, len) == 0)
 		{
-			continue; // Skip empty or invalid entries
+			return true;
 		}
-
-		else
+	}
+	return false;
+}
+// Box that defines the parameter called word[0..len), or -1
+int findParameter(const char *word, int len)
+{
+	for (int k = 1; k < textBoxCount; k++)
+	{
+		if (parameters[k].used && (int)strlen(parameters[k].name) == len && strncmp(parameters[k].name, word, len) == 0)
 		{
+			return k;
+		}
+	}
+	return -1;
+}
+// Fills parameters[i] from func[i] when it reads "f(x) = name = [number][source]"
+void readParameter(int i)
+{
+	Parameter *p = &parameters[i];
+	const char *s = func[i];
+	p->used = false;
 
-			if (funcType[i] == 1)
-			{
-				iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]); // Red color for the graph
-				long double scale = 100;										 // Adjust the scale as needed
-
-				// Initialize the first point
-				double x1 = -100000 / scale;
-				double a = 0, b = 0, c = 0;
-
-				// Check the structure of the function string
-				if (sscanf(func[i], "f(x) = %lfx %lf", &a, &c) == 2)
-				{
-					// For y = mx - c type equation
-					b = 0; // To make it y = mx + (-c)
-				}
-				else if (sscanf(func[i], "f(x) = %lfx + (%lf)", &a, &b) == 2)
-				{
-
-					// For y = mx + c type equation
-					// Do nothing as coefficients are already assigned
-				}
-				else if (sscanf(func[i], "f(x) = %lfx", &a) == 1)
-				{
-					// For y = mx type equation
-					b = 0;
-				}
-				else
-				{
-					// If it's not in the expected format, skip to the next function
-
-					drawState[i] = 3;
-
-					continue;
-				}
-
-				double y1 = evaluateLinearFunction(a, b, x1) - c;
-				int screenY1 = y1 * scale;
-				int screenX1 = -100000 + screenWidth / 2;
+	if (strncmp(s, "f(x) =", 6) != 0)
+	{
+		return;
+	}
+	s += 6;
+	while (*s == ' ')
+		s++;
 
-				for (int j = -100000; j <= 100000; j += 1)
-				{
-					drawState[i] = 2;
+	int len = 0;
+	while (isalpha((unsigned char)s[len]))
+		len++;
+	if (len == 0 || len >= MAX_PARAM_NAME || isReservedName(s, len))
+	{
+		return;
+	}
+	const char *name = s;
+	s += len;
+	while (*s == ' ')
+		s++;
+	if (*s != '=')
+	{
+		return;
+	}
+	s++;
+	while (*s == ' ')
+		s++;
 
-					double x2 = j / scale;
-					double y2 = evaluateLinearFunction(a, b, x2) - c;
-					int screenY2 = y2 * scale;
-					int screenX2 = j + screenWidth / 2;
+	// Optional number, then an optional parameter it multiplies
+	char *end;
+	double number = strtod(s, &end);
+	bool hasNumber = end != s;
+	if (!hasNumber)
+	{
+		number = 1;
+	}
+	s = end;
+	while (*s == ' ')
+		s++;
+	int sourceLen = 0;
+	while (isalpha((unsigned char)s[sourceLen]))
+		sourceLen++;
+	if (sourceLen >= MAX_PARAM_NAME || (sourceLen > 0 && isReservedName(s, sourceLen)) || (!hasNumber && sourceLen == 0))
+	{
+		return;
+	}
+	const char *source = s;
+	s += sourceLen;
+	while (*s == ' ')
+		s++;
+	if (*s != '\0')
+	{
+		return;
+	}
 
-					iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
+	p->used = true;
+	strncpy(p->name, name, len);
+	p->name[len] = '\0';
+	strncpy(p->source, source, sourceLen);
+	p->source[sourceLen] = '\0';
+	p->number = number;
+}
+// Depth-first, so a parameter's source is always resolved before it; a cycle leaves it undefined
+bool resolveParameter(int k)
+{
+	Parameter *p = &parameters[k];
+	if (p->visit == 2)
+	{
+		return p->defined;
+	}
+	if (p->visit == 1)
+	{
+		return false;
+	}
+	p->visit = 1;
 
-					// Update the previous point
-					x1 = x2;
-					y1 = y2;
-					screenY1 = screenY2;
-					screenX1 = screenX2;
-				}
-			}
-			if (funcType[i] == 2)
+	if (p->source[0] == '\0')
+	{
+		p->value = p->number;
+		p->defined = true;
+	}
+	else
+	{
+		int s = findParameter(p->source, strlen(p->source));
+		if (s >= 0)
+		{
+			if (resolveParameter(s))
 			{
-				iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]); // Red color for the graph
-				long double scale = 100;										 // Adjust the scale as needed
-
-				// Initialize the first point
-				double x1 = -100000 / scale;
-				double a = 0, b = 0, c = 0, d = 1, e = 0;
-
-				// Check the structure of the function string
-				readSin(i, a, b, c, d, e);
-				readCos(i, a, b, c, d, e);
-				readTan(i, a, b, c, d, e);
-				readCot(i, a, b, c, d, e);
-				readCosec(i, a, b, c, d, e);
-				readSec(i, a, b, c, d, e);
-
-				if (funcSpec[i][1][1] == 1)
-				{
-
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateSinFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
-
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateSinFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-
-						iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				else if (funcSpec[i][1][2] == 1)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateCosFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
-
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateCosFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-
-						iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				else if (funcSpec[i][1][3] == 1)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateTanFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
-
-					// Inside your loop
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-
-						// Check if tan is undefined
-
-						double y2 = evaluateTanFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				else if (funcSpec[i][1][4] == 1)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = 1 / evaluateTanFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+				p->value = p->number * parameters[s].value;
+				p->defined = true;
+			}
+		}
+		else if (strcmp(p->source, "t") == 0)
+		{
+			p->value = p->number * animationTime;
+			p->defined = true;
+		}
+	}
+	p->visit = 2;
+	return p->defined;
+}
+// Flags every function box that refers to name for reparsing
+void markParameterUsers(const char *name)
+{
+	char key[MAX_PARAM_NAME + 2];
+	sprintf(key, " %s ", name);
+	for (int j = 1; j < textBoxCount; j++)
+	{
+		if (!parameters[j].used && strstr(funcParams[j], key) != NULL)
+		{
+			funcDirty[j] = true;
+		}
+	}
+}
+// Re-resolves all parameters after one definition changed and flags only the
+// boxes that use a parameter whose value changed. oldName is the name the
+// edited box defined before the edit, if any.
+void updateParameters(const char *oldName)
+{
+	for (int k = 1; k < textBoxCount; k++)
+	{
+		parameters[k].previousValue = parameters[k].value;
+		parameters[k].previousDefined = parameters[k].defined;
+		parameters[k].defined = false;
+		parameters[k].visit = 0;
+	}
+	for (int k = 1; k < textBoxCount; k++)
+	{
+		if (parameters[k].used)
+		{
+			resolveParameter(k);
+		}
+	}
 
-					// Inside your loop
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
+	if (oldName[0] != '\0')
+	{
+		markParameterUsers(oldName);
+	}
+	for (int k = 1; k < textBoxCount; k++)
+	{
+		if (parameters[k].used && (parameters[k].defined != parameters[k].previousDefined || parameters[k].value != parameters[k].previousValue))
+		{
+			markParameterUsers(parameters[k].name);
+		}
+	}
+}
+// Value of the parameter called word[0..len): a user parameter first, then the built-in t
+bool lookupParameter(const char *word, int len, double *value)
+{
+	int k = findParameter(word, len);
+	if (k >= 0)
+	{
+		*value = parameters[k].value;
+		return parameters[k].defined;
+	}
+	if (len == 1 && *word == 't')
+	{
+		*value = animationTime;
+		return true;
+	}
+	return false;
+}
+// Advances t. Only the boxes that mention t, directly or through a parameter,
+// are reparsed and resampled; every other curve keeps its cached samples.
+void animate()
+{
+	if (animationPaused)
+	{
+		return;
+	}
+	animationTime += ANIMATION_INTERVAL / 1000.0;
+	updateParameters("");
+	markParameterUsers("t");
+}
+// Splits func[i] of the form "f(x) = name(x) = body" into name and
+// "f(x) = body". Any other text is copied to body whole and name is "".
+void readFunctionName(int i, char *name, char *body)
+{
+	const char *s = func[i];
+	name[0] = '\0';
+	strcpy(body, s);
+	if (strncmp(s, "f(x) =", 6) != 0)
+	{
+		return;
+	}
+	s += 6;
+	while (*s == ' ')
+		s++;
 
-						// Check if tan is undefined
+	int len = 0;
+	while (isalpha((unsigned char)s[len]))
+		len++;
+	if (len == 0 || len >= MAX_PARAM_NAME || isReservedName(s, len) || strncmp(s + len, "(x)", 3) != 0)
+	{
+		return;
+	}
+	const char *rest = s + len + 3;
+	while (*rest == ' ')
+		rest++;
+	if (*rest != '=')
+	{
+		return;
+	}
+	strncpy(name, s, len);
+	name[len] = '\0';
+	sprintf(body, "f(x) =%s", rest + 1);
+}
+// Box whose function is called name, or -1. A box waiting to be parsed is
+// looked up by its text, since funcNames[k] is only set by parsing it.
+int findFunction(const char *name)
+{
+	for (int k = 1; k < textBoxCount; k++)
+	{
+		const char *known = funcNames[k];
+		char current[MAX_PARAM_NAME];
+		char body[MAX_TEXT_LENGTH];
+		if (funcDirty[k])
+		{
+			readFunctionName(k, current, body);
+			known = current;
+		}
+		if (strcmp(known, name) == 0)
+		{
+			return k;
+		}
+	}
+	return -1;
+}
+// Reads "f(x) = [c][*]name(x)[^2] [+- k]" into a = c, e = k and power.
+// Returns false for text of any other form.
+bool readReference(const char *text, char *name, double &a, double &e, int &power)
+{
+	if (strncmp(text, "f(x) =", 6) != 0)
+	{
+		return false;
+	}
+	const char *s = text + 6;
+	while (*s == ' ')
+		s++;
 
-						double y2 = 1 / evaluateTanFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				else if (funcSpec[i][1][5] == 1)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = 1 / evaluateSinFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	// Optional factor; a lone sign stands for 1 or -1
+	char *end;
+	a = strtod(s, &end);
+	if (end == s)
+	{
+		a = 1;
+		if (*s == '-' || *s == '+')
+		{
+			a = *s == '-' ? -1 : 1;
+			s++;
+		}
+	}
+	else
+	{
+		s = end;
+	}
+	while (*s == ' ' || *s == '*')
+		s++;
 
-					// Inside your loop
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
+	int len = 0;
+	while (isalpha((unsigned char)s[len]))
+		len++;
+	if (len == 0 || len >= MAX_PARAM_NAME || isReservedName(s, len) || strncmp(s + len, "(x)", 3) != 0)
+	{
+		return false;
+	}
+	strncpy(name, s, len);
+	name[len] = '\0';
+	s += len + 3;
 
-						// Check if tan is undefined
+	power = 1;
+	if (strncmp(s, "^2", 2) == 0)
+	{
+		power = 2;
+		s += 2;
+	}
+	while (*s == ' ')
+		s++;
 
-						double y2 = 1 / evaluateSinFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				else if (funcSpec[i][1][6] == 1)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = 1 / evaluateCosFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	e = 0;
+	if (*s == '+' || *s == '-')
+	{
+		double sign = *s == '-' ? -1 : 1;
+		s++;
+		while (*s == ' ')
+			s++;
+		e = sign * strtod(s, &end);
+		if (end == s)
+		{
+			return false;
+		}
+		s = end;
+	}
+	while (*s == ' ')
+		s++;
+	return *s == '\0';
+}
+// True if the chain of references drawn from box k leads to box i
+bool referenceReaches(int k, int i)
+{
+	for (int steps = 0; steps < textBoxCount; steps++)
+	{
+		if (k == i)
+		{
+			return true;
+		}
+		const ParsedFunction *q = &previewFunc[k];
+		if (q->state != 2 || q->kind != PARSED_REFERENCE)
+		{
+			return false;
+		}
+		k = q->source;
+	}
+	return true;
+}
+// Reparses box k if its text or a box its curve is built on changed. Sources
+// are brought up to date before their users, so a chain of references is
+// recomputed in dependency order whatever order the boxes are listed in.
+void refreshFunction(int k)
+{
+	const ParsedFunction *preview = &previewFunc[k];
+	if (preview->state == 2 && preview->kind == PARSED_REFERENCE)
+	{
+		int s = preview->source;
+		refreshFunction(s);
+		if (funcVersion[s] != preview->sourceVersion)
+		{
+			funcDirty[k] = true;
+		}
+	}
+	if (funcDirty[k])
+	{
+		parseFunction(k);
+	}
+}
+// Copies source into text with every known parameter replaced by its value,
+// so the sscanf templates below see plain numbers. "ax" is read as a times x;
+// "g(x)" is a function reference and is only recorded.
+void substituteParameters(int i, const char *source, char *text, int size)
+{
+	const char *s = source;
+	int n = 0;
+	int used = 1;
+	strcpy(funcParams[i], " ");
 
-					// Inside your loop
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
+	while (*s != '\0' && n < size - 1)
+	{
+		if (!isalpha((unsigned char)*s))
+		{
+			text[n++] = *s++;
+			continue;
+		}
 
-						// Check if tan is undefined
+		int len = 0;
+		while (isalpha((unsigned char)s[len]))
+			len++;
 
-						double y2 = 1 / evaluateCosFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
+		bool found = false;
+		double value = 0;
+		int nameLen = len;
+		if (!isReservedName(s, len))
+		{
+			found = s[len] != '(' && lookupParameter(s, len, &value);
+			if (!found && s[len] != '(' && len > 1 && s[len - 1] == 'x')
+			{
+				nameLen = len - 1;
+				found = lookupParameter(s, nameLen, &value);
 			}
-			if (funcType[i] == 3)
+			// Remember the name even when it is undefined, so defining it later reparses this box
+			if (nameLen < MAX_PARAM_NAME && used + nameLen + 1 < (int)sizeof(funcParams[i]))
 			{
-				iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]); // Red color for the graph
-				long double scale = 100;										 // Adjust the scale as needed
-
-				// Initialize the first point
-				double x1 = -100000 / scale;
-				double a = 0, b = 0, c = 0, d = 1, e = 0;
+				strncat(funcParams[i], s, nameLen);
+				strcat(funcParams[i], " ");
+				used += nameLen + 1;
+			}
+		}
 
-				// Check the structure of the function string
-				readASin(i, a, b, c, d, e);
-				readACos(i, a, b, c, d, e);
-				readATan(i, a, b, c, d, e);
-				readACot(i, a, b, c, d, e);
-				readACosec(i, a, b, c, d, e);
-				readASec(i, a, b, c, d, e);
+		if (found)
+		{
+			char number[32];
+			sprintf(number, "%.15g", value);
+			for (int c = 0; number[c] != '\0' && n < size - 1; c++)
+				text[n++] = number[c];
+			s += nameLen;
+		}
+		else
+		{
+			for (int c = 0; c < len && n < size - 1; c++)
+				text[n++] = s[c];
+			s += len;
+		}
+	}
+	text[n] = '\0';
+}
+// Field by field, since padding makes memcmp unreliable
+bool sameParsedFunction(const ParsedFunction *p, const ParsedFunction *q)
+{
+	return p->family == q->family && p->degree == q->degree && p->kind == q->kind && p->state == q->state &&
+		   p->checkJump == q->checkJump && p->a == q->a && p->b == q->b && p->c == q->c && p->d == q->d &&
+		   p->e == q->e && p->base == q->base && p->source == q->source && p->sourceVersion == q->sourceVersion &&
+		   p->power == q->power;
+}
+void parseFunction(int i)
+{
+	ParsedFunction *p = &parsedFunc[i];
+	double a = 0, b = 0, c = 0, d = 1, e = 0, base = 10;
 
-				if (funcSpec[i][2][1] == 1)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateAsinFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	p->family = funcType[i];
+	p->degree = funcSpec[i][3][1];
+	p->kind = PARSED_NONE;
+	p->state = 3;
+	p->checkJump = true;
+	p->source = 0;
+	p->sourceVersion = 0;
+	p->power = 1;
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateAsinFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				if (funcSpec[i][2][2] == 2)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateAcosFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	// Parameter boxes draw nothing themselves; they only update their users
+	Parameter before = parameters[i];
+	readParameter(i);
+	if (parameters[i].used || before.used)
+	{
+		updateParameters(before.used ? before.name : "");
+	}
+	char name[MAX_PARAM_NAME];
+	char body[MAX_TEXT_LENGTH];
+	readFunctionName(i, name, body);
+	if (parameters[i].used)
+	{
+		name[0] = '\0';
+	}
+	if (strcmp(name, funcNames[i]) != 0)
+	{
+		// Users of the old name lose their source; users of the new one gain it
+		if (funcNames[i][0] != '\0')
+		{
+			markParameterUsers(funcNames[i]);
+		}
+		if (name[0] != '\0')
+		{
+			markParameterUsers(name);
+		}
+		strcpy(funcNames[i], name);
+	}
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateAcosFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				if (funcSpec[i][2][3] == 3)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateAtanFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	if (parameters[i].used)
+	{
+		p->state = 0;
+		previewFunc[i].state = 0;
+		funcParams[i][0] = '\0';
+		funcDirty[i] = false;
+		return;
+	}
+	// Cleared before any source is reparsed, so a reference cycle cannot come back to this box
+	funcDirty[i] = false;
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateAtanFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				if (funcSpec[i][2][4] == 4)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateAcotFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	char text[2 * MAX_TEXT_LENGTH];
+	substituteParameters(i, body, text, sizeof(text));
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateAcotFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				if (funcSpec[i][2][5] == 5)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateAcosecFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateAcosecFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				if (funcSpec[i][2][6] == 6)
-				{
-					double y1Temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateASecFunction(d, y1Temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2Temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateASecFunction(d, y2Temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
+	char sourceName[MAX_PARAM_NAME];
+	if (readReference(text, sourceName, a, e, p->power))
+	{
+		int k = findFunction(sourceName);
+		if (k >= 0 && k != i)
+		{
+			refreshFunction(k);
+			if (previewFunc[k].state == 2 && !referenceReaches(k, i))
+			{
+				p->kind = PARSED_REFERENCE;
+				p->source = k;
+				p->sourceVersion = funcVersion[k];
+				p->checkJump = previewFunc[k].checkJump;
 			}
-			if (funcType[i] == 4)
+		}
+		b = 0, c = 0, d = 0;
+	}
+	else if (funcType[i] == 1)
+	{
+		d = 0;
+		// Check the structure of the function string
+		if (sscanf(text, "f(x) = %lfx %lf", &a, &c) == 2)
+		{
+			// For y = mx - c type equation
+			b = 0; // To make it y = mx + (-c)
+			p->kind = PARSED_LINEAR;
+		}
+		else if (sscanf(text, "f(x) = %lfx + (%lf)", &a, &b) == 2)
+		{
+			// For y = mx + c type equation
+			p->kind = PARSED_LINEAR;
+		}
+		else if (sscanf(text, "f(x) = %lfx", &a) == 1)
+		{
+			// For y = mx type equation
+			b = 0;
+			p->kind = PARSED_LINEAR;
+		}
+		p->checkJump = false;
+	}
+	else if (funcType[i] == 2)
+	{
+		// The readers only ever set flags, so clear the ones left by the previous text
+		for (int k = 0; k < 7; k++)
+		{
+			funcSpec[i][1][k] = 0;
+		}
+		readSin(i, text, a, b, c, d, e);
+		readCos(i, text, a, b, c, d, e);
+		readTan(i, text, a, b, c, d, e);
+		readCot(i, text, a, b, c, d, e);
+		readCosec(i, text, a, b, c, d, e);
+		readSec(i, text, a, b, c, d, e);
+
+		for (int k = 1; k <= 6; k++)
+		{
+			if (funcSpec[i][1][k] == 1)
 			{
-				iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]); // Red color for the graph
-				long double scale = 100;										 // Adjust the scale as needed
-
-				// Initialize the first point
-				double x1 = -100000 / scale;
-				double a = 0, b = 0, c = 0, d = 1, e = 0;
-
-				// Check the structure of the function string
-				readExp(i, a, b, c, d, e);
-
-				{
-					double y1temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateExpFunction(d, y1temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
-
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-
-						double x2 = j / scale;
-						double y2temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateExpFunction(d, y2temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
+				p->kind = PARSED_SIN + k - 1;
+				break;
 			}
-			if (funcType[i] == 5)
+		}
+		p->checkJump = p->kind != PARSED_SIN && p->kind != PARSED_COS;
+	}
+	else if (funcType[i] == 3)
+	{
+		for (int k = 0; k < 7; k++)
+		{
+			funcSpec[i][2][k] = 0;
+		}
+		readASin(i, text, a, b, c, d, e);
+		readACos(i, text, a, b, c, d, e);
+		readATan(i, text, a, b, c, d, e);
+		readACot(i, text, a, b, c, d, e);
+		readACosec(i, text, a, b, c, d, e);
+		readASec(i, text, a, b, c, d, e);
+
+		for (int k = 1; k <= 6; k++)
+		{
+			if (funcSpec[i][2][k] == k)
 			{
-				iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]); // Red color for the graph
-				long double scale = 100;										 // Adjust the scale as needed
-
-				// Initialize the first point
-				double x1 = -100000 / scale;
-				double a = 0, b = 0, c = 0, d = 1, e = 0, base = 10;
-
-				// Check the structure of the function string
-				readLog(i, a, b, c, d, e, base);
+				p->kind = PARSED_ASIN + k - 1;
+				break;
+			}
+		}
+	}
+	else if (funcType[i] == 4)
+	{
+		readExp(i, text, a, b, c, d, e);
+		p->kind = PARSED_EXP;
+	}
+	else if (funcType[i] == 5)
+	{
+		readLog(i, text, a, b, c, d, e, base);
+		p->kind = PARSED_LOG;
+	}
+	else if (funcType[i] == 6)
+	{
+		readLn(i, text, a, b, c, d, e);
+		p->kind = PARSED_LN;
+	}
+	else if (funcType[i] == 7)
+	{
+		a = 1, d = 0;
+		if (funcSpec[i][3][1] == 2)
+		{
+			readQuadratic(i, text, a, b, c);
+			p->kind = PARSED_QUADRATIC;
+		}
+		else if (funcSpec[i][3][1] == 3)
+		{
+			readCubic(i, text, a, b, c, d);
+			p->kind = PARSED_CUBIC;
+		}
+		else if (funcSpec[i][3][1] == 4)
+		{
+			readTetra(i, text, a, b, c, d, e);
+			p->kind = PARSED_TETRA;
+		}
+		else
+		{
+			// No degree picked yet
+			p->state = 0;
+		}
+		p->checkJump = false;
+	}
 
-				{
-					double y1temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateLogFunction(d, y1temp, base) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	if (p->kind != PARSED_NONE)
+	{
+		p->state = 2;
+	}
+	p->a = a;
+	p->b = b;
+	p->c = c;
+	p->d = d;
+	p->e = e;
+	p->base = base;
+	funcDirty[i] = false;
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-
-						double x2 = j / scale;
-						double y2temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateLogFunction(d, y2temp, base) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-			}
-			if (funcType[i] == 6)
+	if (p->state == 2)
+	{
+		// Reparsing unchanged text keeps the cached samples and display list
+		if (!sameParsedFunction(p, &previewFunc[i]))
+		{
+			funcVersion[i]++;
+			if (funcNames[i][0] != '\0')
 			{
-				iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]); // Red color for the graph
-				long double scale = 100;										 // Adjust the scale as needed
+				markParameterUsers(funcNames[i]);
+			}
+		}
+		previewFunc[i] = *p;
+	}
+	else if (previewFunc[i].family != p->family || previewFunc[i].degree != p->degree)
+	{
+		// A preview of another type of function would be misleading
+		previewFunc[i].state = 0;
+	}
+}
+double evaluateParsedFunction(const ParsedFunction *p, double x)
+{
+	double inner = evaluateLinearFunction(p->a, p->b, x) - p->c;
+
+	switch (p->kind)
+	{
+	case PARSED_LINEAR:
+		return inner;
+	case PARSED_SIN:
+		return evaluateSinFunction(p->d, inner) + p->e;
+	case PARSED_COS:
+		return evaluateCosFunction(p->d, inner) + p->e;
+	case PARSED_TAN:
+		return evaluateTanFunction(p->d, inner) + p->e;
+	case PARSED_COT:
+		return 1 / evaluateTanFunction(p->d, inner) + p->e;
+	case PARSED_COSEC:
+		return 1 / evaluateSinFunction(p->d, inner) + p->e;
+	case PARSED_SEC:
+		return 1 / evaluateCosFunction(p->d, inner) + p->e;
+	case PARSED_ASIN:
+		return evaluateAsinFunction(p->d, inner) + p->e;
+	case PARSED_ACOS:
+		return evaluateAcosFunction(p->d, inner) + p->e;
+	case PARSED_ATAN:
+		return evaluateAtanFunction(p->d, inner) + p->e;
+	case PARSED_ACOT:
+		return evaluateAcotFunction(p->d, inner) + p->e;
+	case PARSED_ACOSEC:
+		return evaluateAcosecFunction(p->d, inner) + p->e;
+	case PARSED_ASEC:
+		return evaluateASecFunction(p->d, inner) + p->e;
+	case PARSED_EXP:
+		return evaluateExpFunction(p->d, inner) + p->e;
+	case PARSED_LOG:
+		return evaluateLogFunction(p->d, inner, p->base) + p->e;
+	case PARSED_LN:
+		return evaluateLnFunction(p->d, inner) + p->e;
+	case PARSED_QUADRATIC:
+		return p->a * x * x + p->b * x + p->c;
+	case PARSED_CUBIC:
+		return p->a * x * x * x + p->b * x * x + p->c * x + p->d;
+	case PARSED_TETRA:
+		return p->a * x * x * x * x + p->b * x * x * x + p->c * x * x + p->d * x + p->e;
+	case PARSED_REFERENCE:
+	{
+		double y = evaluateParsedFunction(&previewFunc[p->source], x);
+		return p->a * (p->power == 2 ? y * y : y) + p->e;
+	}
+	}
+	return 0;
+}
 
-				// Initialize the first point
-				double x1 = -100000 / scale;
-				double a = 0, b = 0, c = 0, d = 1, e = 0;
+// True if curve i's samples still cover columns jStart..jEnd of its current definition
+bool curveCacheFresh(int i, int jStart, int jEnd)
+{
+	CurveCache *cache = &curveCache[i];
+	return cache->screenY != NULL && cache->version == funcVersion[i] && jStart >= cache->first && jEnd < cache->first + cache->count;
+}
+bool reserveCurveCache(int i, int count)
+{
+	CurveCache *cache = &curveCache[i];
+	if (count > cache->capacity)
+	{
+		int *screenY = (int *)realloc(cache->screenY, count * sizeof(int));
+		if (screenY == NULL)
+		{
+			return false;
+		}
+		cache->screenY = screenY;
+		cache->capacity = count;
+	}
+	return true;
+}
+// Samples every curve listed in stale over the same columns first..first+count-1.
+// The abscissae of a tile are worked out once and shared by all the curves;
+// each curve's results go to its own cache, one column of samples per curve.
+void sampleCurves(const int *stale, int staleCount, int first, int count)
+{
+	long double scale = 100; // Adjust the scale as needed
+	double x[SAMPLE_TILE];
+	for (int k0 = 0; k0 < count; k0 += SAMPLE_TILE)
+	{
+		int n = count - k0 < SAMPLE_TILE ? count - k0 : SAMPLE_TILE;
+		for (int k = 0; k < n; k++)
+		{
+			x[k] = (first + k0 + k) / scale;
+		}
+		for (int s = 0; s < staleCount; s++)
+		{
+			const ParsedFunction *p = &previewFunc[stale[s]];
+			int *screenY = curveCache[stale[s]].screenY + k0;
+			for (int k = 0; k < n; k++)
+			{
+				screenY[k] = evaluateParsedFunction(p, x[k]) * scale;
+			}
+		}
+	}
+	for (int s = 0; s < staleCount; s++)
+	{
+		CurveCache *cache = &curveCache[stale[s]];
+		cache->version = funcVersion[stale[s]];
+		cache->first = first;
+		cache->count = count;
+	}
+}
+// Records curve i's samples as GL_LINES in world pixels; drawFunc pans them
+// with the modelview matrix, so until the next resample a pan costs one glCallList
+bool recordCurveList(int i)
+{
+	CurveCache *cache = &curveCache[i];
+	if (cache->list == 0)
+	{
+		cache->list = glGenLists(1);
+		if (cache->list == 0)
+		{
+			cache->count = 0; // sampled again next frame
+			return false;
+		}
+	}
+	glNewList(cache->list, GL_COMPILE);
+	glBegin(GL_LINES);
+	for (int k = 1; k < cache->count; k++)
+	{
+		int screenY1 = cache->screenY[k - 1];
+		int screenY2 = cache->screenY[k];
+		if (!previewFunc[i].checkJump || abs(screenY2 - screenY1) <= 1000)
+		{
+			int screenX2 = cache->first + k + screenWidth / 2;
+			glVertex2i(screenX2 - 1, screenY1 + screenHeight / 2);
+			glVertex2i(screenX2, screenY2 + screenHeight / 2);
+		}
+	}
+	glEnd();
+	glEndList();
+	return true;
+}
+// Brings box i's parse record up to date and says whether it has a curve to draw
+bool prepareCurve(int i)
+{
+	if (strlen(func[i]) <= 7 || funcType[i] == 0 || showCurve[i] == 1)
+	{
+		return false; // Skip empty or invalid entries
+	}
 
-				// Check the structure of the function string
-				readLn(i, a, b, c, d, e);
+	// Parse only when the text, the type or the degree changed since last time
+	ParsedFunction *p = &parsedFunc[i];
+	if (p->family != funcType[i] || p->degree != funcSpec[i][3][1])
+	{
+		funcDirty[i] = true;
+	}
+	refreshFunction(i);
+	if (p->state != 0)
+	{
+		drawState[i] = p->state; // 3 flags the text as malformed
+	}
 
-				{
-					double y1temp = evaluateLinearFunction(a, b, x1) - c;
-					double y1 = evaluateLnFunction(d, y1temp) + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	// While the text is mid-edit the last version that parsed is drawn
+	ParsedFunction *preview = &previewFunc[i];
+	return preview->state == 2 && preview->family == funcType[i] && preview->degree == funcSpec[i][3][1];
+}
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-
-						double x2 = j / scale;
-						double y2temp = evaluateLinearFunction(a, b, x2) - c;
-						double y2 = evaluateLnFunction(d, y2temp) + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						if (abs(screenY2 - screenY1) <= 1000)
-						{
-							iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						}
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
+void drawFunc()
+{
+	// Columns inside the window, one sample per pixel; the caches keep more around them
+	int jStart = (int)floor(offsetX) - screenWidth / 2 - CURVE_MARGIN;
+	int jEnd = (int)ceil(offsetX) + screenWidth / 2 + CURVE_MARGIN;
+	int first = jStart - CURVE_SLACK;
+	int count = jEnd - jStart + 1 + 2 * CURVE_SLACK;
+
+	// Every stale curve is resampled over the same columns in one pass
+	int staleCount = 0;
+	for (int i = 1; i < textBoxCount; ++i)
+	{
+		curveReady[i] = prepareCurve(i);
+		if (curveReady[i] && !curveCacheFresh(i, jStart, jEnd))
+		{
+			if (reserveCurveCache(i, count))
+			{
+				staleCurves[staleCount++] = i;
 			}
-			if (funcType[i] == 7)
+			else
 			{
-				iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]); // Red color for the graph
-				long double scale = 100;
-				double a = 1, b = 0, c = 0, d = 0, e = 0;
-				if (funcSpec[i][3][1] == 2)
-				{
-					readQuadratic(i, a, b, c);
+				curveReady[i] = false;
+			}
+		}
+	}
+	if (staleCount > 0)
+	{
+		sampleCurves(staleCurves, staleCount, first, count);
+		for (int s = 0; s < staleCount; s++)
+		{
+			if (!recordCurveList(staleCurves[s]))
+			{
+				curveReady[staleCurves[s]] = false;
+			}
+		}
+	}
 
-					double x1 = -100000 / scale;
-					double y1 = a * x1 * x1 + b * x1 + c;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	for (int i = 1; i < textBoxCount; ++i)
+	{
+		if (!curveReady[i])
+		{
+			continue;
+		}
+		// Samples restored from a session have no display list until their first frame
+		if (curveCache[i].list == 0 && !recordCurveList(i))
+		{
+			continue;
+		}
+		iSetColor(graphColor[i][0], graphColor[i][1], graphColor[i][2]);
+		glLineWidth(2.0);
+		glPushMatrix();
+		glTranslated(-offsetX, -offsetY, 0);
+		glCallList(curveCache[i].list);
+		glPopMatrix();
+		glLineWidth(1.0);
+	}
+}
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2 = a * x2 * x2 + b * x2 + c;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				else if (funcSpec[i][3][1] == 3)
-				{
-					readCubic(i, a, b, c, d);
-					double x1 = -100000 / scale;
-					double y1 = a * x1 * x1 * x1 + b * x1 * x1 + c * x1 + d;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+// Worksheet saved with F7 and restored at startup. The binary file holds
+// every box's text together with its parse records, so nothing is parsed
+// again on load, plus the colours, the view and, for curves whose samples
+// are current, the samples themselves. It is read through a memory map and
+// copied straight into the registry. session.txt is written next to it for
+// people to read; it is never loaded.
+#define SESSION_FILE "session.gps"
+#define SESSION_TEXT_FILE "session.txt"
+#define SESSION_VERSION 2
+struct SessionHeader
+{
+	char magic[4]; // "GPS1"
+	int version;
+	int headerSize; // sizeof(SessionHeader) and sizeof(SessionBox) when written;
+	int boxSize;	// a build with other record layouts refuses the file
+	int boxCount;	// boxes 1..boxCount, box 0 is never used
+	int animationPaused;
+	double offsetX, offsetY;
+	double animationTime;
+};
+struct SessionBox
+{
+	char text[MAX_TEXT_LENGTH];
+	int funcType;
+	int funcSpec[4][7];
+	int colorFlag;
+	int showCurve;
+	double color[3];
+	ParsedFunction parsed;
+	ParsedFunction preview;
+	Parameter parameter;
+	char params[2 * MAX_TEXT_LENGTH];
+	char name[MAX_PARAM_NAME];
+	int sampleFirst; // column of the first sample
+	int sampleCount; // 0 when no samples were saved
+	long long sampleOffset; // file offset of sampleCount ints
+};
+
+// Screen x the text cursor of a box reaches after typing text, by the same
+// per-character advances iKeyboard uses
+void restoreTextCursor(int i)
+{
+	cursorIndex[i] = 111;
+	cursorIndex2[i] = 0;
+	offsetX1[i] = 0;
+	for (const char *s = func[i] + 6; *s != '\0'; s++)
+	{
+		int advance = 11;
+		if (*s == 't' || *s == 'i' || *s == 'f' || *s == 'l')
+			advance = 7;
+		else if (*s == 'w' || *s == 'm')
+			advance = 18;
+		else if (*s == '+')
+			advance = 13;
+
+		if (cursorIndex[i] < windowWidth - 52)
+		{
+			cursorIndex[i] += advance;
+		}
+		else
+		{
+			offsetX1[i] += 11;
+			cursorIndex2[i] += advance;
+		}
+	}
+}
+bool saveSession()
+{
+	int boxCount = textBoxCount - 1;
+	SessionBox *boxes = (SessionBox *)calloc(boxCount > 0 ? boxCount : 1, sizeof(SessionBox));
+	if (boxes == NULL)
+	{
+		logMessage(LOG_ERROR, "Not enough memory to save the session\n");
+		return false;
+	}
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2 = a * x2 * x2 * x2 + b * x2 * x2 + c * x2 + d;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-				else if (funcSpec[i][3][1] == 4)
-				{
-					readTetra(i, a, b, c, d, e);
-					double x1 = -100000 / scale;
-					double y1 = a * x1 * x1 * x1 * x1 + b * x1 * x1 * x1 + c * x1 * x1 + d * x1 + e;
-					int screenY1 = y1 * scale;
-					int screenX1 = -100000 + screenWidth / 2;
+	long long offset = sizeof(SessionHeader) + (long long)boxCount * sizeof(SessionBox);
+	for (int i = 1; i < textBoxCount; i++)
+	{
+		SessionBox *box = &boxes[i - 1];
+		strcpy(box->text, func[i]);
+		box->funcType = funcType[i];
+		memcpy(box->funcSpec, funcSpec[i], sizeof(box->funcSpec));
+		box->colorFlag = colorFlag[i];
+		box->showCurve = showCurve[i];
+		memcpy(box->color, graphColor[i], sizeof(box->color));
+		box->parsed = parsedFunc[i];
+		box->preview = previewFunc[i];
+		box->parameter = parameters[i];
+		strcpy(box->params, funcParams[i]);
+		strcpy(box->name, funcNames[i]);
+
+		// Samples of an edit that has not been drawn yet would not match the records
+		const CurveCache *cache = &curveCache[i];
+		if (!funcDirty[i] && cache->screenY != NULL && cache->version == funcVersion[i])
+		{
+			box->sampleFirst = cache->first;
+			box->sampleCount = cache->count;
+			box->sampleOffset = offset;
+			offset += (long long)cache->count * sizeof(int);
+		}
+	}
 
-					for (int j = -100000; j <= 100000; j += 1)
-					{
-						drawState[i] = 2;
-						double x2 = j / scale;
-						double y2 = a * x2 * x2 * x2 * x2 + b * x2 * x2 * x2 + c * x2 * x2 + d * x2 + e;
-						int screenY2 = y2 * scale;
-						int screenX2 = j + screenWidth / 2;
-						iLine(screenX1 - offsetX, screenY1 + screenHeight / 2 - offsetY, screenX2 - offsetX, screenY2 + screenHeight / 2 - offsetY, 2.0); // Draw a line between points
-						// Update the previous point
-						x1 = x2;
-						y1 = y2;
-						screenY1 = screenY2;
-						screenX1 = screenX2;
-					}
-				}
-			}
+	SessionHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "GPS1", 4);
+	header.version = SESSION_VERSION;
+	header.headerSize = sizeof(SessionHeader);
+	header.boxSize = sizeof(SessionBox);
+	header.boxCount = boxCount;
+	header.animationPaused = animationPaused;
+	header.offsetX = offsetX;
+	header.offsetY = offsetY;
+	header.animationTime = animationTime;
+
+	// Written beside the old file and swapped in, so a failed save leaves the last session intact
+	FILE *out = fopen(SESSION_FILE ".tmp", "wb");
+	bool ok = out != NULL;
+	if (ok)
+	{
+		setvbuf(out, NULL, _IOFBF, 1 << 16);
+		ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+			 (boxCount == 0 || fwrite(boxes, sizeof(SessionBox), boxCount, out) == (size_t)boxCount);
+		for (int i = 1; ok && i < textBoxCount; i++)
+		{
+			int count = boxes[i - 1].sampleCount;
+			ok = count == 0 || fwrite(curveCache[i].screenY, sizeof(int), count, out) == (size_t)count;
 		}
+		ok = fclose(out) == 0 && ok;
+	}
+	free(boxes);
+	if (!ok || !MoveFileExA(SESSION_FILE ".tmp", SESSION_FILE, MOVEFILE_REPLACE_EXISTING))
+	{
+		logMessage(LOG_ERROR, "Could not write %s\n", SESSION_FILE);
+		return false;
+	}
+
+	FILE *text = fopen(SESSION_TEXT_FILE, "w");
+	if (text != NULL)
+	{
+		fprintf(text, "# GraphStudio session, view offset %.17g %.17g, t = %.17g\n", offsetX, offsetY, animationTime);
+		for (int i = 1; i < textBoxCount; i++)
+		{
+			fprintf(text, "%s\tcolor %.0f %.0f %.0f%s\n", func[i], graphColor[i][0], graphColor[i][1], graphColor[i][2],
+					showCurve[i] ? "\thidden" : "");
+		}
+		fclose(text);
+	}
+	logMessage(LOG_INFO, "Saved %d functions to %s\n", boxCount, SESSION_FILE);
+	return true;
+}
+// Restores the worksheet saved by saveSession(). Runs before the window
+// opens: the display lists of restored samples are recorded by drawFunc().
+bool loadSession()
+{
+	HANDLE file = CreateFileA(SESSION_FILE, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false; // nothing saved yet
+	}
+	DWORD size = GetFileSize(file, NULL);
+	HANDLE mapping = size >= sizeof(SessionHeader) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	const char *view = mapping != NULL ? (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+	const SessionHeader *header = (const SessionHeader *)view;
+	const SessionBox *boxes = (const SessionBox *)(view + sizeof(SessionHeader));
+	bool ok = view != NULL && memcmp(header->magic, "GPS1", 4) == 0 && header->version == SESSION_VERSION &&
+			  header->headerSize == sizeof(SessionHeader) && header->boxSize == sizeof(SessionBox) &&
+			  header->boxCount >= 0 && header->boxCount <= (long long)((size - sizeof(SessionHeader)) / sizeof(SessionBox)) &&
+			  ensureRegistryCapacity(header->boxCount + 2);
+
+	for (int i = 1; ok && i <= header->boxCount; i++)
+	{
+		const SessionBox *box = &boxes[i - 1];
+		memcpy(func[i], box->text, MAX_TEXT_LENGTH);
+		func[i][MAX_TEXT_LENGTH - 1] = '\0';
+		funcType[i] = box->funcType;
+		memcpy(funcSpec[i], box->funcSpec, sizeof(box->funcSpec));
+		colorFlag[i] = box->colorFlag;
+		showCurve[i] = box->showCurve;
+		memcpy(graphColor[i], box->color, sizeof(box->color));
+		parsedFunc[i] = box->parsed;
+		previewFunc[i] = box->preview;
+		parameters[i] = box->parameter;
+		memcpy(funcParams[i], box->params, sizeof(box->params));
+		funcParams[i][sizeof(box->params) - 1] = '\0';
+		memcpy(funcNames[i], box->name, sizeof(box->name));
+		funcNames[i][sizeof(box->name) - 1] = '\0';
+		funcDirty[i] = false;
+		funcVersion[i] = 1;
+		// Every version restarts at 1, so references were parsed against the current one
+		previewFunc[i].sourceVersion = 1;
+		parsedFunc[i].sourceVersion = 1;
+		drawState[i] = box->parsed.state;
+
+		textBoxPositions[i] = i * 70;
+		indexNumber[i + 1] = strlen(func[i]);
+		restoreTextCursor(i);
+
+		long long end = box->sampleOffset + (long long)box->sampleCount * sizeof(int);
+		if (box->sampleCount > 0 && box->sampleOffset >= 0 && end <= (long long)size && reserveCurveCache(i, box->sampleCount))
+		{
+			memcpy(curveCache[i].screenY, view + box->sampleOffset, box->sampleCount * sizeof(int));
+			curveCache[i].version = funcVersion[i];
+			curveCache[i].first = box->sampleFirst;
+			curveCache[i].count = box->sampleCount;
+		}
+	}
+	if (ok)
+	{
+		textBoxCount = header->boxCount + 1;
+		offsetX = header->offsetX;
+		offsetY = header->offsetY;
+		animationTime = header->animationTime;
+		animationPaused = header->animationPaused != 0;
+		logMessage(LOG_INFO, "Restored %d functions from %s\n", header->boxCount, SESSION_FILE);
+	}
+	else
+	{
+		logMessage(LOG_ERROR, "%s is not a session this build can read\n", SESSION_FILE);
 	}
+
+	if (view != NULL)
+		UnmapViewOfFile(view);
+	if (mapping != NULL)
+		CloseHandle(mapping);
+	CloseHandle(file);
+	return ok;
 }
 
 void iDraw()
@@ -3036,6 +3868,13 @@ void iDraw()
 		instructions2();
 		myself();
 	}
+
+	if (!firstFrameDrawn)
+	{
+		firstFrameDrawn = true;
+		logMessage(LOG_INFO, "First frame after %lu ms, %d bitmaps mapped from %s, %d decoded on %d threads\n",
+				   (unsigned long)(GetTickCount() - programStart), packedSprites, ASSET_PACK_FILE, decodeCount, decodeThreads);
+	}
 }
 
 void iMouseMove(int x, int y)
@@ -3045,11 +3884,11 @@ void iMouseMove(int x, int y)
 		if (!showFloatingWindow)
 		{
 
-			printf("x = %d, y= %d\n", x, y);
+			logMessage(LOG_DEBUG, "x = %d, y= %d\n", x, y);
 			// place your codes here
 			offsetX -= (x - mouseX); // Reverse the sign for x-axis
 			offsetY += (mouseY - y); // Invert Y-axis
-			printf("offsetX %lf offsetY %lf\n", offsetX, offsetY);
+			logMessage(LOG_DEBUG, "offsetX %lf offsetY %lf\n", offsetX, offsetY);
 			mouseX = x;
 			mouseY = y;
 		}
@@ -3059,7 +3898,7 @@ void iMouseMove(int x, int y)
 			{
 				offsetX -= (x - mouseX); // Reverse the sign for x-axis
 				offsetY += (mouseY - y); // Invert Y-axis
-				printf("offsetX %lf offsetY %lf\n", offsetX, offsetY);
+				logMessage(LOG_DEBUG, "offsetX %lf offsetY %lf\n", offsetX, offsetY);
 				mouseX = x;
 				mouseY = y;
 			}
@@ -3083,7 +3922,7 @@ void iMouseMove(int x, int y)
 				if (offsetY1 <= 0)
 				{
 					offsetY1 += (mouseY - y);
-					printf("offsetY1 %lf\n", offsetY1);
+					logMessage(LOG_DEBUG, "offsetY1 %lf\n", offsetY1);
 					mouseY = y;
 					if (textBoxCount > 4)
 					{
@@ -3120,7 +3959,7 @@ void iMouseMove(int x, int y)
 					if (offsetY1 <= 0)
 					{
 						offsetY1 += (mouseY - y);
-						printf("offsetY1 %lf\n", offsetY1);
+						logMessage(LOG_DEBUG, "offsetY1 %lf\n", offsetY1);
 						mouseY = y;
 						if (textBoxCount > 4)
 						{
@@ -3164,7 +4003,7 @@ void iMouse(int button, int state, int mx, int my)
 	if (button == GLUT_LEFT_BUTTON && state == GLUT_DOWN)
 	{
 		// place your codes here
-		printf("x = %d, y= %d\n", mx, my);
+		logMessage(LOG_DEBUG, "x = %d, y= %d\n", mx, my);
 		//		x += 10;
 		//		y += 10;
 		mouseX = mx;
@@ -3191,7 +4030,7 @@ void iMouse(int button, int state, int mx, int my)
 
 			if (mx >= angleX && mx <= angleX + angleWidth && my >= angleY && my <= angleY + angleHeight)
 			{
-				if (textBoxCount < MAX_TEXTBOXES)
+				if (ensureRegistryCapacity(textBoxCount + 2)) // the new box and indexNumber[textBoxCount + 1]
 				{
 					if (textBoxCount == 1)
 					{
@@ -3201,6 +4040,7 @@ void iMouse(int button, int state, int mx, int my)
 						indexNumber[textBoxCount] = 6;
 						strcpy(func[textBoxCount - 1], "f(x) =");
 						func[textBoxCount - 1][indexNumber[textBoxCount]] = '\0';
+						funcDirty[textBoxCount - 1] = true;
 					}
 					else if (leftAngle == true)
 					{
@@ -3209,6 +4049,7 @@ void iMouse(int button, int state, int mx, int my)
 						indexNumber[textBoxCount] = 6;
 						strcpy(func[textBoxCount - 1], "f(x) =");
 						func[textBoxCount - 1][indexNumber[textBoxCount]] = '\0';
+						funcDirty[textBoxCount - 1] = true;
 					}
 				}
 			}
@@ -3264,6 +4105,8 @@ void iMouse(int button, int state, int mx, int my)
 			if (mouseX >= 320 && mouseX <= 320 + 24 && mouseY >= windowHeight - textBoxPositions[selectedTextBox] - offsetY1 - 18 && mouseY <= windowHeight - textBoxPositions[selectedTextBox] - offsetY1 + 17 && showFuncList == false)
 			{
 
+				Parameter removed = parameters[selectedTextBox];
+				CurveCache removedCache = curveCache[selectedTextBox];
 				indexNumber[selectedTextBox] = 0;
 				funcType[selectedTextBox] = 0;
 				func[selectedTextBox][indexNumber[selectedTextBox]] = '\0';
@@ -3275,7 +4118,15 @@ void iMouse(int button, int state, int mx, int my)
 
 					strcpy(func[j], func[i]);
 					funcType[j] = funcType[i];
+					memcpy(funcSpec[j], funcSpec[i], sizeof(funcSpec[j]));
 					drawState[j] = drawState[i];
+					previewFunc[j] = previewFunc[i];
+					curveCache[j] = curveCache[i];
+					funcVersion[j] = funcVersion[i];
+					parameters[j] = parameters[i];
+					strcpy(funcParams[j], funcParams[i]);
+					strcpy(funcNames[j], funcNames[i]);
+					funcDirty[j] = true;
 					indexNumber[j + 1] = strlen(func[j]);
 					cursorIndex[j] = cursorIndex[i];
 
@@ -3288,6 +4139,35 @@ void iMouse(int button, int state, int mx, int my)
 				textBoxPositions[i - 1] = 0;
 				funcType[i - 1] = 0;
 				drawState[i - 1] = 0;
+				previewFunc[i - 1].state = 0;
+				// The freed slot keeps the removed box's buffers, sampled again before use
+				curveCache[i - 1] = removedCache;
+				curveCache[i - 1].count = 0;
+				parameters[i - 1].used = false;
+				funcParams[i - 1][0] = '\0';
+				funcNames[i - 1][0] = '\0';
+				// References follow their source up a slot; those to the removed box look their name up again
+				for (int k = 1; k < textBoxCount; k++)
+				{
+					ParsedFunction *records[2] = {&previewFunc[k], &parsedFunc[k]};
+					for (int r = 0; r < 2; r++)
+					{
+						if (records[r]->kind != PARSED_REFERENCE)
+						{
+							continue;
+						}
+						if (records[r]->source == selectedTextBox)
+						{
+							records[r]->state = 0;
+							funcDirty[k] = true;
+						}
+						else if (records[r]->source > selectedTextBox)
+						{
+							records[r]->source--;
+						}
+					}
+				}
+				updateParameters(removed.used ? removed.name : "");
 				// cursorIndex[i-1]=0;
 			}
 			if (mouseX >= 11 && mouseX <= 41 && mouseY >= windowHeight - textBoxPositions[selectedTextBox] - offsetY1 - 10 && mouseY <= windowHeight - textBoxPositions[selectedTextBox] - offsetY1 + 20)
@@ -3402,6 +4282,10 @@ void iKeyboard(unsigned char key)
 
 				if (key != '\b')
 				{
+					if (indexNumber[selectedTextBox + 1] >= MAX_TEXT_LENGTH - 1)
+					{
+						return; // the box is full; its row keeps room for the terminator
+					}
 					if (indexNumber[selectedTextBox + 1] >= 6)
 					{
 						// Allow editing "f(x)=" portion
@@ -3494,10 +4378,12 @@ void iKeyboard(unsigned char key)
 						}
 					}
 				}
+				// Only the edited box is reparsed; the others keep their records and samples
+				parseFunction(selectedTextBox);
 			}
 			else
 			{
-				if (textBoxCount < MAX_TEXTBOXES)
+				if (ensureRegistryCapacity(textBoxCount + 2)) // the new box and indexNumber[textBoxCount + 1]
 				{
 					// Add a new textbox position
 					textBoxPositions[textBoxCount] = textBoxCount * 70;
@@ -3507,6 +4393,7 @@ void iKeyboard(unsigned char key)
 					indexNumber[textBoxCount] = 6;
 					strcpy(func[textBoxCount - 1], "f(x) =");
 					func[textBoxCount - 1][indexNumber[textBoxCount]] = '\0';
+					funcDirty[textBoxCount - 1] = true;
 				}
 			}
 		}
@@ -3531,13 +4418,35 @@ void iSpecialKeyboard(unsigned char key)
 	{
 		// Move the cursor to the left
 	}
+	if (key == GLUT_KEY_F5)
+	{
+		animationPaused = !animationPaused;
+	}
+	if (key == GLUT_KEY_F6)
+	{
+		logLevel = (logLevel == LOG_DEBUG) ? LOG_INFO : LOG_DEBUG;
+	}
+	if (key == GLUT_KEY_F7)
+	{
+		saveSession();
+	}
 	// place your codes for other keys here
 }
 
 int main()
 {
 	// place your own initialization codes here.
+	programStart = GetTickCount();
+	startSpriteDecoding();
+	if (!ensureRegistryCapacity(INITIAL_TEXTBOXES))
+	{
+		logMessage(LOG_ERROR, "Not enough memory for the function boxes\n");
+		return 1;
+	}
+	startLogWriter();
+	loadSession();
 	iSetTimer(400, change);
+	iSetTimer(ANIMATION_INTERVAL, animate);
 	iInitialize(screenWidth, screenHeight, "GraphStudio");
 
 	glutMotionFunc(iMouseMove);
@@ -16,6 +16,9 @@
 #include <math.h>
 #include <windows.h>
 #include <GL/glaux.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -85,6 +88,38 @@ void iResumeTimer(int index){
     }
 }
 
+//
+// Sets the alpha of RGBA pixels in place: 0 where a pixel's colour, read as
+// the 0xBBGGRR value iShowBMP2 compares, equals ignoreColor, and 255
+// everywhere else. When built with SSE2 (-msse2, always on for 64-bit) eight
+// pixels are keyed per step; the remainder, and other builds, go one by one.
+//
+void iColorKeyPixels(unsigned char *pixels, int nPixels, int ignoreColor)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i opaque = _mm_set1_epi32((int)0xFF000000);
+    const __m128i key = _mm_set1_epi32(ignoreColor);
+    for (; i + 8 <= nPixels; i += 8)
+    {
+        __m128i *p = (__m128i *)(pixels + 4 * i);
+        __m128i a = _mm_and_si128(_mm_loadu_si128(p), rgbMask);
+        __m128i b = _mm_and_si128(_mm_loadu_si128(p + 1), rgbMask);
+        a = _mm_or_si128(a, _mm_andnot_si128(_mm_cmpeq_epi32(a, key), opaque));
+        b = _mm_or_si128(b, _mm_andnot_si128(_mm_cmpeq_epi32(b, key), opaque));
+        _mm_storeu_si128(p, a);
+        _mm_storeu_si128(p + 1, b);
+    }
+#endif
+    for (; i < nPixels; i++)
+    {
+        unsigned char *p = pixels + 4 * i;
+        int bgr = p[0] | (p[1] << 8) | (p[2] << 16);
+        p[3] = (bgr == ignoreColor) ? 0 : 255;
+    }
+}
+
 //
 // Puts a BMP image on screen
 //
@@ -188,29 +223,14 @@ void iShowBMP2(int x, int y, char filename[], int ignoreColor)
     int  width, height, n;
     stbi_set_flip_vertically_on_load(1);
     unsigned char* image = stbi_load(filename, &width, &height, &n, 4);
+    if (image == NULL) return;
 
-    int nPixels = width * height;
-    int *rgPixels = new int[nPixels];
-
-    int i,j;
-    for (i = 0, j=0; i < nPixels; i++, j += 4)
-    {
-        int bgr = 0;
-        for(int k = 2; k >= 0; k--)
-        {
-            bgr = ((bgr << 8) | image[j+k]);
-
-        }
-        //printf("%x\n",bgr);
-
-        rgPixels[i] = (bgr == ignoreColor) ? 0 : 255;
-        rgPixels[i] = ((rgPixels[i] << 24) | bgr);
-    }
+    // stbi_load already gives the R, G, B, A byte order glDrawPixels takes,
+    // so only the alpha needs setting and the image is keyed where it lies
+    iColorKeyPixels(image, width * height, ignoreColor);
 
     glRasterPos2f(x, y);
-    //glDrawPixels(width, height, GL_RGBA, GL_UNSIGNED_BYTE, image);
-    glDrawPixels(width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgPixels);
-    delete[] rgPixels;
+    glDrawPixels(width, height, GL_RGBA, GL_UNSIGNED_BYTE, image);
 
     stbi_image_free(image);
 
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <stdarg.h>
 
 // Constants for window dimensions
 #define WINDOW_WIDTH 800
@@ -36,9 +37,21 @@
 #define MIN_SCALE 5
 #define MAX_SCALE 1000
 
+// Adaptive sampling
+#define CHORD_TOLERANCE 0.25       // Max distance in pixels between a segment and the curve
+#define MAX_SEGMENT_PIXELS 4.0     // Longest segment, in pixels, even where the curve is straight
+#define NEWTON_MAX_ITERATIONS 30
+#define EXP_HOIST_LIMIT 16.0       // largest |C| folded out of exp(Bx + C); keeps exp(Bx) in range
+
+// Data series
+#define DATA_BASE_SHIFT 3          // finest pyramid buckets hold 8 rows
+#define DATA_MAX_LEVELS 40
+#define STREAM_CAPACITY (1 << 20)  // streamed points kept, power of two
+#define STREAM_FOLLOW_MARGIN 20    // pixels left right of the newest streamed point
+
 // Function declarations (prototypes)
 void removeWhitespaces(char *str);
-float parseNumber(char **ptr);
+double parseNumber(const char **ptr);
 int readPolynomial(const char* equation, float *a4, float *a3, float *a2, float *a1, float *a0);
 int readTrigFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType);
 int readInverseTrigFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType);
@@ -73,6 +86,10 @@ bool isSettingColor = false;
 bool showGridFlag = false;
 bool isEnteringEquation = false;
 bool isPanning = false;
+bool showDerivatives = false;
+bool showTangent = false;
+bool showData = false;
+bool showStream = false;
 
 char userInput[MAX_INPUT_LENGTH] = "";
 char equationInput[MAX_INPUT_LENGTH] = "";
@@ -84,6 +101,7 @@ char inputBuffer[100] = "";
 int inputStep = 0; // 0: function name, 1: R, 2: G, 3: B
 int inputIndex = 0;
 int lastMouseX, lastMouseY;
+double tangentX = 0;   // world x of the tangent probe
 
 double coefficients[MAX_COEFFICIENTS] = {0};
 
@@ -267,6 +285,8 @@ Color colorCircle = {255, 0, 255};     // Magenta
 Color colorEllipse = {0, 255, 255};    // Cyan
 Color colorParabola = {128, 0, 128};   // Purple
 Color colorHyperbola = {255, 255, 0};  // Yellow
+Color colorData = {200, 200, 200};     // Light Gray
+Color colorStream = {0, 255, 127};     // Spring Green
 
 // Helper Functions
 
@@ -303,429 +323,270 @@ void removeWhitespaces(char *str) {
     *i = 0;
 }
 
-float parseNumber(char **ptr) {
-    float num = 0;
-    int sign = 1;
-
-    if (**ptr == '-') {
-        sign = -1;
-        (*ptr)++;
-    } else if (**ptr == '+') {
-        (*ptr)++;
-    }
-
-    // Read integer part
-    while (isdigit(**ptr)) {
-        num = num * 10 + (**ptr - '0');
-        (*ptr)++;
-    }
+// Equation lexer. Tokens point into the caller's string instead of copies,
+// and whitespace is skipped while scanning, so nothing is cleaned up front.
+#define TOKEN_END 0
+#define TOKEN_NUMBER 1
+#define TOKEN_NAME 2      // run of letters: sin, asin, exp, x, y, ...
+#define TOKEN_SYMBOL 3    // any other single character: + - * / ^ ( ) =
 
-    // Read fractional part
-    if (**ptr == '.') {
-        (*ptr)++;
-        float factor = 0.1;
-        while (isdigit(**ptr)) {
-            num += (**ptr - '0') * factor;
-            factor *= 0.1;
-            (*ptr)++;
-        }
-    }
+typedef struct {
+    int type;
+    const char *start;    // first character in the original equation
+    int len;
+    double value;         // TOKEN_NUMBER only
+} Token;
 
-    return sign * num;
+typedef struct {
+    const char *pos;      // first character after the current token
+    Token token;          // current token
+} Lexer;
+
+// Length of the unsigned number at s: digits, optional fraction and an
+// optional exponent (1.5e-3). Returns 0 when s does not start a number.
+static int scanNumber(const char *s) {
+    const char *p = s;
+    while (isdigit((unsigned char)*p)) p++;
+    if (*p == '.') {
+        p++;
+        while (isdigit((unsigned char)*p)) p++;
+    }
+    if (p == s || (p == s + 1 && *s == '.')) return 0;
+
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+        if (*q == '+' || *q == '-') q++;
+        if (isdigit((unsigned char)*q)) {
+            while (isdigit((unsigned char)*q)) q++;
+            p = q;
+        }
+    }
+    return p - s;
 }
 
-int readPolynomial(const char* equation, float *a4, float *a3, float *a2, float *a1, float *a0) {
-    *a4 = 0; *a3 = 0; *a2 = 0; *a1 = 0; *a0 = 0;
-
-    char cleanEq[MAX_INPUT_LENGTH];
-    strcpy(cleanEq, equation);
-    removeWhitespaces(cleanEq);
-
-    char *ptr = cleanEq;
-    char term[MAX_INPUT_LENGTH];
-    int len = strlen(cleanEq);
-    int idx = 0;
-    int termIdx = 0;
-    int sign = 1;
-
-    while (idx <= len) {
-        if (cleanEq[idx] == '+' || cleanEq[idx] == '-' || cleanEq[idx] == '\0') {
-            term[termIdx] = '\0';
-
-            if (termIdx > 0) {
-                // Parse the term
-                float coeff = 0;
-                int power = 0;
-                char *xPtr = strchr(term, 'x');
-
-                if (xPtr) {
-                    if (xPtr == term) {
-                        coeff = 1.0f * sign;
-                    } else {
-                        char coeffStr[MAX_INPUT_LENGTH];
-                        strncpy(coeffStr, term, xPtr - term);
-                        coeffStr[xPtr - term] = '\0';
-                        coeff = atof(coeffStr) * sign;
-                    }
-
-                    char *powPtr = strchr(term, '^');
-                    if (powPtr) {
-                        power = atoi(powPtr + 1);
-                    } else {
-                        power = 1;
-                    }
-                } else {
-                    coeff = atof(term) * sign;
-                    power = 0;
-                }
-
-                // Assign to appropriate coefficient
-                switch (power) {
-                case 4: *a4 += coeff; break;
-                case 3: *a3 += coeff; break;
-                case 2: *a2 += coeff; break;
-                case 1: *a1 += coeff; break;
-                case 0: *a0 += coeff; break;
-                default: break;
-                }
-            }
+// Converts a span found by scanNumber. strtod rounds correctly and stops at
+// the end of the span; the one exception is a lone "0" before an 'x', which
+// it would read as a hex prefix, so single digits are converted directly.
+static double convertNumber(const char *s, int len) {
+    if (len == 1) return *s - '0';
+    return strtod(s, NULL);
+}
 
-            // Reset for next term
-            termIdx = 0;
-            sign = (cleanEq[idx] == '-') ? -1 : 1;
-        } else {
-            term[termIdx++] = cleanEq[idx];
-        }
-        idx++;
+static void nextToken(Lexer *lex) {
+    const char *p = lex->pos;
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+
+    Token *t = &lex->token;
+    t->start = p;
+    t->value = 0;
+
+    int n;
+    if (*p == '\0') {
+        t->type = TOKEN_END;
+        t->len = 0;
+    } else if ((n = scanNumber(p)) > 0) {
+        t->type = TOKEN_NUMBER;
+        t->len = n;
+        t->value = convertNumber(p, n);
+    } else if (isalpha((unsigned char)*p)) {
+        n = 0;
+        while (isalpha((unsigned char)p[n])) n++;
+        t->type = TOKEN_NAME;
+        t->len = n;
+    } else {
+        t->type = TOKEN_SYMBOL;
+        t->len = 1;
     }
+    lex->pos = p + t->len;
+}
 
-    return 1; // Parsing successful
+static void startLexer(Lexer *lex, const char *text) {
+    lex->pos = text;
+    nextToken(lex);
 }
 
-int readTrigFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType) {
-    *A = 1.0f; *B = 1.0f; *C = 0.0f; *D = 0.0f;
-    char cleanEq[MAX_INPUT_LENGTH];
-    strncpy(cleanEq, equation, MAX_INPUT_LENGTH - 1);
-    removeWhitespaces(cleanEq);
+static bool isSymbol(const Token *t, char c) {
+    return t->type == TOKEN_SYMBOL && *t->start == c;
+}
 
-    char *funcPtr = strstr(cleanEq, funcType);
-    if (!funcPtr) return 0;
+static bool isName(const Token *t, const char *name) {
+    return t->type == TOKEN_NAME && t->len == (int)strlen(name) && strncmp(t->start, name, t->len) == 0;
+}
 
-    // Handle coefficient A (amplitude)
-    char *ptr = cleanEq;
-    if (strncmp(ptr, "y=", 2) == 0) ptr += 2;
+static bool acceptSymbol(Lexer *lex, char c) {
+    if (!isSymbol(&lex->token, c)) return false;
+    nextToken(lex);
+    return true;
+}
 
-    if (ptr != funcPtr) {
-        if (ptr[0] == '-' && ptr + 1 == funcPtr) {
-            *A = -1.0f;
-        } else {
-            char coeffStr[MAX_INPUT_LENGTH];
-            strncpy(coeffStr, ptr, funcPtr - ptr);
-            coeffStr[funcPtr - ptr] = '\0';
-            if (strlen(coeffStr) > 0) {
-                *A = atof(coeffStr);
-            }
-        }
-    }
+static bool acceptName(Lexer *lex, const char *name) {
+    if (!isName(&lex->token, name)) return false;
+    nextToken(lex);
+    return true;
+}
 
-    // Find opening and closing parentheses
-    ptr = funcPtr + strlen(funcType);
-    if (*ptr == '(') ptr++;
-    char *closePtr = strchr(ptr, ')');
-    if (!closePtr) return 0;
+// Skips a leading "y=" or "f(x)="
+static void skipAssignment(Lexer *lex) {
+    Lexer save = *lex;
+    if (acceptName(lex, "y") && acceptSymbol(lex, '=')) return;
+    *lex = save;
+    if (acceptName(lex, "f") && acceptSymbol(lex, '(') && acceptName(lex, "x") &&
+        acceptSymbol(lex, ')') && acceptSymbol(lex, '=')) return;
+    *lex = save;
+}
 
-    // Parse inner function (Bx + C)
-    char innerFunc[MAX_INPUT_LENGTH];
-    strncpy(innerFunc, ptr, closePtr - ptr);
-    innerFunc[closePtr - ptr] = '\0';
-
-    char *xPtr = strchr(innerFunc, 'x');
-    if (xPtr) {
-        // Handle B (coefficient of x)
-        if (xPtr == innerFunc) {
-            *B = 1.0f;
-        } else if (xPtr == innerFunc + 1 && innerFunc[0] == '-') {
-            *B = -1.0f;
-        } else {
-            char bStr[MAX_INPUT_LENGTH];
-            strncpy(bStr, innerFunc, xPtr - innerFunc);
-            bStr[xPtr - innerFunc] = '\0';
-            if (strlen(bStr) > 0) {
-                *B = atof(bStr);
-            }
-        }
+// [+|-] [number] [*] in front of a name. The value is +-1 when the number is
+// omitted; returns whether a number was actually written.
+static bool readCoefficient(Lexer *lex, double *value) {
+    double sign = 1;
+    if (acceptSymbol(lex, '-')) sign = -1;
+    else acceptSymbol(lex, '+');
 
-        // Handle C (phase shift)
-        ptr = xPtr + 1;
-        if (*ptr == '+' || *ptr == '-') {
-            *C = atof(ptr);
-        }
-    }
+    *value = sign;
+    if (lex->token.type != TOKEN_NUMBER) return false;
 
-    // Handle D (vertical shift)
-    ptr = closePtr + 1;
-    while (*ptr == ' ') ptr++; // Skip spaces
+    *value = sign * lex->token.value;
+    nextToken(lex);
+    acceptSymbol(lex, '*');
+    return true;
+}
 
-    if (*ptr) {
-        if (*ptr == '+') {
-            *D = atof(ptr + 1);
-        } else if (*ptr == '-') {
-            *D = -atof(ptr + 1);
-        }
-    }
+// (+|-) number, or 0 when no such offset follows
+static double readOffset(Lexer *lex) {
+    if (!isSymbol(&lex->token, '+') && !isSymbol(&lex->token, '-')) return 0;
 
-    return 1;
+    Lexer save = *lex;
+    double sign = *lex->token.start == '-' ? -1 : 1;
+    nextToken(lex);
+    if (lex->token.type == TOKEN_NUMBER) {
+        double value = sign * lex->token.value;
+        nextToken(lex);
+        return value;
+    }
+    *lex = save;
+    return 0;
 }
 
+double parseNumber(const char **ptr) {
+    const char *p = *ptr;
+    double sign = 1;
 
-int readInverseTrigFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType) {
-    *A = 1.0f; *B = 1.0f; *C = 0.0f; *D = 0.0f;
-    char cleanEq[MAX_INPUT_LENGTH];
-    strncpy(cleanEq, equation, MAX_INPUT_LENGTH - 1);
-    removeWhitespaces(cleanEq);
-
-    // Check for different inverse trig notations
-    char *funcPtr = NULL;
-    if (strstr(cleanEq, "asin")) {
-        funcPtr = strstr(cleanEq, "asin");
-        strcpy(funcType, "asin");
-    } else if (strstr(cleanEq, "asin")) {
-        funcPtr = strstr(cleanEq, "asin");
-        strcpy(funcType, "asin");
-    } else if (strstr(cleanEq, "acos")) {
-        funcPtr = strstr(cleanEq, "acos");
-        strcpy(funcType, "acos");
-    } else if (strstr(cleanEq, "acos")) {
-        funcPtr = strstr(cleanEq, "acos");
-        strcpy(funcType, "acos");
-    } else if (strstr(cleanEq, "atan")) {
-        funcPtr = strstr(cleanEq, "atan");
-        strcpy(funcType, "atan");
-    } else if (strstr(cleanEq, "atan")) {
-        funcPtr = strstr(cleanEq, "atan");
-        strcpy(funcType, "atan");
-    }
-
-    if (!funcPtr) return 0;
+    if (*p == '-') {
+        sign = -1;
+        p++;
+    } else if (*p == '+') {
+        p++;
+    }
 
-    // Handle coefficient A (amplitude)
-    char *ptr = cleanEq;
-    if (strncmp(ptr, "y=", 2) == 0) ptr += 2;
+    int len = scanNumber(p);
+    if (len == 0) return 0;
 
-    if (ptr != funcPtr) {
-        if (ptr[0] == '-' && ptr + 1 == funcPtr) {
-            *A = -1.0f;
-        } else {
-            char coeffStr[MAX_INPUT_LENGTH];
-            strncpy(coeffStr, ptr, funcPtr - ptr);
-            coeffStr[funcPtr - ptr] = '\0';
-            if (strlen(coeffStr) > 0) {
-                *A = atof(coeffStr);
-            }
-        }
-    }
+    *ptr = p + len;
+    return sign * convertNumber(p, len);
+}
 
-    // Find opening and closing parentheses
-    ptr = funcPtr + strlen(funcType);
-    if (*ptr == '(') ptr++;
-    char *closePtr = strchr(ptr, ')');
-    if (!closePtr) return 0;
+int readPolynomial(const char* equation, float *a4, float *a3, float *a2, float *a1, float *a0) {
+    *a4 = 0; *a3 = 0; *a2 = 0; *a1 = 0; *a0 = 0;
 
-    // Parse inner function (Bx + C)
-    char innerFunc[MAX_INPUT_LENGTH];
-    strncpy(innerFunc, ptr, closePtr - ptr);
-    innerFunc[closePtr - ptr] = '\0';
-
-    char *xPtr = strchr(innerFunc, 'x');
-    if (xPtr) {
-        // Handle B (coefficient of x)
-        if (xPtr == innerFunc) {
-            *B = 1.0f;
-        } else if (xPtr == innerFunc + 1 && innerFunc[0] == '-') {
-            *B = -1.0f;
-        } else {
-            char bStr[MAX_INPUT_LENGTH];
-            strncpy(bStr, innerFunc, xPtr - innerFunc);
-            bStr[xPtr - innerFunc] = '\0';
-            if (strlen(bStr) > 0) {
-                *B = atof(bStr);
+    Lexer lex;
+    startLexer(&lex, equation);
+    skipAssignment(&lex);
+
+    while (lex.token.type != TOKEN_END) {
+        // Parse the term
+        double coeff;
+        bool hasNumber = readCoefficient(&lex, &coeff);
+        int power = -1;
+
+        if (acceptName(&lex, "x")) {
+            power = 1;
+            if (acceptSymbol(&lex, '^') && lex.token.type == TOKEN_NUMBER) {
+                power = (int)lex.token.value;
+                nextToken(&lex);
             }
+        } else if (hasNumber) {
+            power = 0;
         }
 
-        // Handle C (horizontal shift)
-        ptr = xPtr + 1;
-        if (*ptr == '+' || *ptr == '-') {
-            *C = atof(ptr);
+        // Assign to appropriate coefficient
+        switch (power) {
+        case 4: *a4 += coeff; break;
+        case 3: *a3 += coeff; break;
+        case 2: *a2 += coeff; break;
+        case 1: *a1 += coeff; break;
+        case 0: *a0 += coeff; break;
+        default: break;
         }
-    }
 
-    // Handle D (vertical shift)
-    ptr = closePtr + 1;
-    while (*ptr == ' ') ptr++; // Skip spaces
-
-    if (*ptr) {
-        if (*ptr == '+') {
-            *D = atof(ptr + 1);
-        } else if (*ptr == '-') {
-            *D = -atof(ptr + 1);
+        // Anything else up to the next sign is ignored
+        while (lex.token.type != TOKEN_END && !isSymbol(&lex.token, '+') && !isSymbol(&lex.token, '-')) {
+            nextToken(&lex);
         }
     }
 
-    return 1;
+    return 1; // Parsing successful
 }
 
-
-int readExponentialFunction(const char* equation, float *A, float *B, float *C, float *D) {
+// Shared by the trig, inverse trig, exponential and log readers:
+//   [y=] [A] name( [B]x [+-C] ) [+-D]
+static int readAffineFunction(const char* equation, const char *name, float *A, float *B, float *C, float *D) {
     *A = 1.0f; *B = 1.0f; *C = 0.0f; *D = 0.0f;
-    char cleanEq[MAX_INPUT_LENGTH];
-    strncpy(cleanEq, equation, MAX_INPUT_LENGTH - 1);
-    removeWhitespaces(cleanEq);
-
-    char *expPtr = strstr(cleanEq, "exp");
-    if (!expPtr) return 0;
-
-    // Handle coefficient A
-    char *ptr = cleanEq;
-    if (strncmp(ptr, "y=", 2) == 0) ptr += 2;
 
-    if (ptr != expPtr) {
-        if (ptr[0] == '-' && ptr + 1 == expPtr) {
-            *A = -1.0f;
-        } else {
-            char coeffStr[MAX_INPUT_LENGTH];
-            strncpy(coeffStr, ptr, expPtr - ptr);
-            coeffStr[expPtr - ptr] = '\0';
-            if (strlen(coeffStr) > 0) {
-                *A = atof(coeffStr);
-            }
-        }
-    }
+    Lexer lex;
+    startLexer(&lex, equation);
+    skipAssignment(&lex);
 
-    // Find opening and closing parentheses
-    ptr = expPtr + 3; // Move past "exp"
-    if (*ptr == '(') ptr++;
-    char *closePtr = strchr(ptr, ')');
-    if (!closePtr) return 0;
+    // Handle coefficient A (amplitude)
+    double a;
+    readCoefficient(&lex, &a);
+    if (!acceptName(&lex, name)) return 0;
+    acceptSymbol(&lex, '(');
 
     // Parse inner function (Bx + C)
-    char innerFunc[MAX_INPUT_LENGTH];
-    strncpy(innerFunc, ptr, closePtr - ptr);
-    innerFunc[closePtr - ptr] = '\0';
-
-    char *xPtr = strchr(innerFunc, 'x');
-    if (xPtr) {
-        // Handle B
-        if (xPtr == innerFunc) {
-            *B = 1.0f;
-        } else if (xPtr == innerFunc + 1 && innerFunc[0] == '-') {
-            *B = -1.0f;
-        } else {
-            char bStr[MAX_INPUT_LENGTH];
-            strncpy(bStr, innerFunc, xPtr - innerFunc);
-            bStr[xPtr - innerFunc] = '\0';
-            if (strlen(bStr) > 0) {
-                *B = atof(bStr);
-            }
-        }
-
-        // Handle C
-        ptr = xPtr + 1;
-        if (*ptr == '+' || *ptr == '-') {
-            *C = atof(ptr);
-        }
+    Lexer inner = lex;
+    double b;
+    readCoefficient(&lex, &b);
+    if (acceptName(&lex, "x")) {
+        *B = b;
+        *C = readOffset(&lex);
+    } else {
+        lex = inner;
     }
 
-    // Handle D (vertical shift)
-    ptr = closePtr + 1;
-    while (*ptr == ' ') ptr++;
-
-    if (*ptr) {
-        if (*ptr == '+') {
-            *D = atof(ptr + 1);
-        } else if (*ptr == '-') {
-            *D = -atof(ptr + 1);
-        }
-    }
+    while (lex.token.type != TOKEN_END && !isSymbol(&lex.token, ')')) nextToken(&lex);
+    if (!acceptSymbol(&lex, ')')) return 0;
 
+    *A = a;
+    // Handle D (vertical shift)
+    *D = readOffset(&lex);
     return 1;
 }
 
+int readTrigFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType) {
+    return readAffineFunction(equation, funcType, A, B, C, D);
+}
 
-int readLogFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType) {
-    *A = 1.0f; *B = 1.0f; *C = 0.0f; *D = 0.0f;
-    char cleanEq[MAX_INPUT_LENGTH];
-    strncpy(cleanEq, equation, MAX_INPUT_LENGTH - 1);
-    removeWhitespaces(cleanEq);
-
-    char *logPtr = strstr(cleanEq, funcType);
-    if (!logPtr) return 0;
-
-    char *ptr = cleanEq;
-    if (strncmp(ptr, "y=", 2) == 0) ptr += 2;
 
-    // Handle coefficient A (before log/ln)
-    if (ptr != logPtr) {
-        if (ptr[0] == '-' && ptr + 1 == logPtr) {
-            *A = -1.0f;
-        } else {
-            char coeffStr[MAX_INPUT_LENGTH];
-            strncpy(coeffStr, ptr, logPtr - ptr);
-            coeffStr[logPtr - ptr] = '\0';
-            if (strlen(coeffStr) > 0) {
-                *A = atof(coeffStr);
-            }
+int readInverseTrigFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType) {
+    // Check for different inverse trig notations
+    static const char *names[] = {"asin", "acos", "atan"};
+    for (int i = 0; i < 3; i++) {
+        if (readAffineFunction(equation, names[i], A, B, C, D)) {
+            strcpy(funcType, names[i]);
+            return 1;
         }
     }
+    return 0;
+}
 
-    // Find the opening parenthesis
-    ptr = logPtr + strlen(funcType);
-    if (*ptr == '(') ptr++;
-
-    // Find the closing parenthesis
-    char *closePtr = strchr(ptr, ')');
-    if (!closePtr) return 0;
-
-    // Parse the inner part (Bx + C)
-    char innerFunc[MAX_INPUT_LENGTH];
-    strncpy(innerFunc, ptr, closePtr - ptr);
-    innerFunc[closePtr - ptr] = '\0';
-
-    char *xPtr = strchr(innerFunc, 'x');
-    if (xPtr) {
-        // Handle coefficient B (before x)
-        if (xPtr == innerFunc) {
-            *B = 1.0f;
-        } else if (xPtr == innerFunc + 1 && innerFunc[0] == '-') {
-            *B = -1.0f;
-        } else {
-            char bStr[MAX_INPUT_LENGTH];
-            strncpy(bStr, innerFunc, xPtr - innerFunc);
-            bStr[xPtr - innerFunc] = '\0';
-            if (strlen(bStr) > 0) {
-                *B = atof(bStr);
-            }
-        }
-
-        // Handle C (after x)
-        ptr = xPtr + 1;
-        if (*ptr == '+' || *ptr == '-') {
-            *C = atof(ptr);
-        }
-    }
 
-    // Handle D (vertical shift) - after the closing parenthesis
-    ptr = closePtr + 1;
-    while (*ptr == ' ') ptr++; // Skip any spaces
+int readExponentialFunction(const char* equation, float *A, float *B, float *C, float *D) {
+    return readAffineFunction(equation, "exp", A, B, C, D);
+}
 
-    if (*ptr) {
-        if (*ptr == '+') {
-            *D = atof(ptr + 1);
-        } else if (*ptr == '-') {
-            *D = -atof(ptr + 1);
-        }
-    }
 
-    return 1;
+int readLogFunction(const char* equation, float *A, float *B, float *C, float *D, char *funcType) {
+    return readAffineFunction(equation, funcType, A, B, C, D);
 }
 
 int readCircle(const char *equation, float *h, float *k, float *r) {
@@ -1069,14 +930,532 @@ double evaluateFunction(double x, const char* func) {
     return 0;
 }
 
-void plotFunction(const char* func, double r, double g, double b) {
+// Families that compileFunction() can bind to a dedicated kernel
+#define FUNC_INTERPRETED 0
+#define FUNC_SIN 1
+#define FUNC_COS 2
+#define FUNC_TAN 3
+#define FUNC_ASIN 4
+#define FUNC_ACOS 5
+#define FUNC_ATAN 6
+#define FUNC_EXP 7
+#define FUNC_LOG 8
+#define FUNC_LN 9
+#define FUNC_POLY 10
+#define FUNC_CONSTANT 11    // produced by optimizeFunction(), value in D
+
+// Shapes of the affine wrapper y = A * f(B * x + C) + D after optimizeFunction()
+#define AFFINE_FULL 0       // A * f(B * x + C) + D
+#define AFFINE_INNER 1      // A * f(x) + D        (B == 1, C == 0)
+#define AFFINE_OUTER 2      // f(B * x + C)        (A == 1, D == 0)
+#define AFFINE_BARE 3       // f(x)
+
+// Compiled form of a plotted function. The family is resolved and the
+// coefficients are copied out of the custom* structs once per curve, so
+// sampling no longer walks the strcmp chain in evaluateFunction() per x.
+typedef struct CompiledFunction {
+    int family;
+    int shape;                      // AFFINE_* for the non-polynomial families
+    int degree;                     // highest non-zero power for FUNC_POLY
+    double A, B, C, D;              // y = A * f(B * x + C) + D
+    double a4, a3, a2, a1, a0;      // polynomial coefficients
+    const char *name;               // used by the interpreted fallback
+    double (*eval)(const struct CompiledFunction *cf, double x);
+} CompiledFunction;
+
+static double evalInterpretedKernel(const CompiledFunction *cf, double x) {
+    return evaluateFunction(x, cf->name);
+}
+
+// Domain-checked versions of the inverse functions; INFINITY marks a gap
+static double guardedAsin(double input) {
+    if (input < -1 || input > 1) return INFINITY;
+    return asin(input);
+}
+
+static double guardedAcos(double input) {
+    if (input < -1 || input > 1) return INFINITY;
+    return acos(input);
+}
+
+static double guardedLog10(double input) {
+    if (input <= 0) return INFINITY;
+    return log10(input);
+}
+
+static double guardedLn(double input) {
+    if (input <= 0) return INFINITY;
+    return log(input);
+}
+
+// One kernel per affine shape plus a batch loop that dispatches on the shape
+// once instead of once per sample.
+#define DEFINE_AFFINE_KERNELS(name, fn) \
+    static double name##Kernel(const CompiledFunction *cf, double x) { return cf->A * fn(cf->B * x + cf->C) + cf->D; } \
+    static double name##InnerKernel(const CompiledFunction *cf, double x) { return cf->A * fn(x) + cf->D; } \
+    static double name##OuterKernel(const CompiledFunction *cf, double x) { return fn(cf->B * x + cf->C); } \
+    static double name##BareKernel(const CompiledFunction *cf, double x) { (void)cf; return fn(x); } \
+    static void name##Select(CompiledFunction *cf) { \
+        switch (cf->shape) { \
+        case AFFINE_INNER: cf->eval = name##InnerKernel; break; \
+        case AFFINE_OUTER: cf->eval = name##OuterKernel; break; \
+        case AFFINE_BARE:  cf->eval = name##BareKernel; break; \
+        default:           cf->eval = name##Kernel; break; \
+        } \
+    } \
+    static void name##Batch(const CompiledFunction *cf, const double *x, double *y, int n) { \
+        int i; \
+        switch (cf->shape) { \
+        case AFFINE_INNER: for (i = 0; i < n; i++) y[i] = name##InnerKernel(cf, x[i]); break; \
+        case AFFINE_OUTER: for (i = 0; i < n; i++) y[i] = name##OuterKernel(cf, x[i]); break; \
+        case AFFINE_BARE:  for (i = 0; i < n; i++) y[i] = name##BareKernel(cf, x[i]); break; \
+        default:           for (i = 0; i < n; i++) y[i] = name##Kernel(cf, x[i]); break; \
+        } \
+    }
+
+DEFINE_AFFINE_KERNELS(evalSin, sin)
+DEFINE_AFFINE_KERNELS(evalCos, cos)
+DEFINE_AFFINE_KERNELS(evalTan, tan)
+DEFINE_AFFINE_KERNELS(evalASin, guardedAsin)
+DEFINE_AFFINE_KERNELS(evalACos, guardedAcos)
+DEFINE_AFFINE_KERNELS(evalATan, atan)
+DEFINE_AFFINE_KERNELS(evalExp, exp)
+DEFINE_AFFINE_KERNELS(evalLog, guardedLog10)
+DEFINE_AFFINE_KERNELS(evalLn, guardedLn)
+
+static double evalConstantKernel(const CompiledFunction *cf, double x) {
+    (void)x;
+    return cf->D;
+}
+
+// Polynomials in Horner form, one kernel per degree so that missing leading
+// terms cost nothing and pow() is never called.
+static double evalPoly0Kernel(const CompiledFunction *cf, double x) {
+    (void)x;
+    return cf->a0;
+}
+
+static double evalPoly1Kernel(const CompiledFunction *cf, double x) {
+    return cf->a1 * x + cf->a0;
+}
+
+static double evalPoly2Kernel(const CompiledFunction *cf, double x) {
+    return (cf->a2 * x + cf->a1) * x + cf->a0;
+}
+
+static double evalPoly3Kernel(const CompiledFunction *cf, double x) {
+    return ((cf->a3 * x + cf->a2) * x + cf->a1) * x + cf->a0;
+}
+
+static double evalPolyKernel(const CompiledFunction *cf, double x) {
+    return (((cf->a4 * x + cf->a3) * x + cf->a2) * x + cf->a1) * x + cf->a0;
+}
+
+static void setAffineCoefficients(CompiledFunction *cf, float A, float B, float C, float D) {
+    cf->A = A; cf->B = B; cf->C = C; cf->D = D;
+}
+
+// Simplifies a compiled function before it is sampled:
+//  - constant folding: B == 0 (and A == 0 for bounded f) collapse to a constant
+//  - identity removal: B == 1, C == 0 and A == 1, D == 0 pick a leaner kernel
+//  - hoisting: A * exp(Bx + C) becomes (A * e^C) * exp(Bx) while |C| is small
+//    and A * e^C is a normal double, so neither factor overflows or underflows
+//  - strength reduction: polynomial powers become a Horner multiply chain
+// There is no common-subexpression pass: each family's template evaluates
+// its inner term B*x + C once and shares no other subterm to reuse.
+void optimizeFunction(CompiledFunction *cf) {
+    if (cf->family == FUNC_INTERPRETED || cf->family == FUNC_CONSTANT) return;
+
+    if (cf->family == FUNC_POLY) {
+        cf->degree = cf->a4 != 0 ? 4 : cf->a3 != 0 ? 3 : cf->a2 != 0 ? 2 : cf->a1 != 0 ? 1 : 0;
+        switch (cf->degree) {
+        case 0: cf->eval = evalPoly0Kernel; break;
+        case 1: cf->eval = evalPoly1Kernel; break;
+        case 2: cf->eval = evalPoly2Kernel; break;
+        case 3: cf->eval = evalPoly3Kernel; break;
+        default: cf->eval = evalPolyKernel; break;
+        }
+        return;
+    }
+
+    bool bounded = cf->family == FUNC_SIN || cf->family == FUNC_COS || cf->family == FUNC_ATAN;
+    if (cf->B == 0 || (cf->A == 0 && bounded)) {
+        cf->D = cf->eval(cf, 0);
+        cf->family = FUNC_CONSTANT;
+        cf->eval = evalConstantKernel;
+        return;
+    }
+
+    if (cf->family == FUNC_EXP && cf->C != 0 && fabs(cf->C) <= EXP_HOIST_LIMIT) {
+        double scaled = cf->A * exp(cf->C);
+        if (isnormal(scaled)) {
+            cf->A = scaled;
+            cf->C = 0;
+        }
+    }
+
+    bool unitInner = cf->B == 1 && cf->C == 0;
+    bool unitOuter = cf->A == 1 && cf->D == 0;
+    if (unitInner && unitOuter) cf->shape = AFFINE_BARE;
+    else if (unitInner) cf->shape = AFFINE_INNER;
+    else if (unitOuter) cf->shape = AFFINE_OUTER;
+    else cf->shape = AFFINE_FULL;
+
+    switch (cf->family) {
+    case FUNC_SIN:  evalSinSelect(cf); break;
+    case FUNC_COS:  evalCosSelect(cf); break;
+    case FUNC_TAN:  evalTanSelect(cf); break;
+    case FUNC_ASIN: evalASinSelect(cf); break;
+    case FUNC_ACOS: evalACosSelect(cf); break;
+    case FUNC_ATAN: evalATanSelect(cf); break;
+    case FUNC_EXP:  evalExpSelect(cf); break;
+    case FUNC_LOG:  evalLogSelect(cf); break;
+    case FUNC_LN:   evalLnSelect(cf); break;
+    }
+}
+
+// Binds func (one of the names accepted by evaluateFunction) to a kernel and
+// runs optimizeFunction() on it. Returns 0 when the name is unknown; cf then
+// falls back to evaluateFunction().
+int compileFunction(const char *func, CompiledFunction *cf) {
+    memset(cf, 0, sizeof(*cf));
+    cf->family = FUNC_INTERPRETED;
+    cf->shape = AFFINE_FULL;
+    cf->name = func;
+    cf->eval = evalInterpretedKernel;
+
+    if (strcmp(func, "custom_sin") == 0) {
+        cf->family = FUNC_SIN; cf->eval = evalSinKernel;
+        setAffineCoefficients(cf, customSin.A, customSin.B, customSin.C, customSin.D);
+    } else if (strcmp(func, "custom_cos") == 0) {
+        cf->family = FUNC_COS; cf->eval = evalCosKernel;
+        setAffineCoefficients(cf, customCos.A, customCos.B, customCos.C, customCos.D);
+    } else if (strcmp(func, "custom_tan") == 0) {
+        cf->family = FUNC_TAN; cf->eval = evalTanKernel;
+        setAffineCoefficients(cf, customTan.A, customTan.B, customTan.C, customTan.D);
+    } else if (strcmp(func, "custom_asin") == 0) {
+        cf->family = FUNC_ASIN; cf->eval = evalASinKernel;
+        setAffineCoefficients(cf, customASin.A, customASin.B, customASin.C, customASin.D);
+    } else if (strcmp(func, "custom_acos") == 0) {
+        cf->family = FUNC_ACOS; cf->eval = evalACosKernel;
+        setAffineCoefficients(cf, customACos.A, customACos.B, customACos.C, customACos.D);
+    } else if (strcmp(func, "custom_atan") == 0) {
+        cf->family = FUNC_ATAN; cf->eval = evalATanKernel;
+        setAffineCoefficients(cf, customATan.A, customATan.B, customATan.C, customATan.D);
+    } else if (strcmp(func, "exponential") == 0) {
+        cf->family = FUNC_EXP; cf->eval = evalExpKernel;
+        setAffineCoefficients(cf, customExp.A, customExp.B, customExp.C, customExp.D);
+    } else if (strcmp(func, "logarithm") == 0) {
+        cf->family = FUNC_LOG; cf->eval = evalLogKernel;
+        setAffineCoefficients(cf, customLog.A, customLog.B, customLog.C, customLog.D);
+    } else if (strcmp(func, "natural_log") == 0) {
+        cf->family = FUNC_LN; cf->eval = evalLnKernel;
+        setAffineCoefficients(cf, customLn.A, customLn.B, customLn.C, customLn.D);
+    } else if (strcmp(func, "polynomial") == 0) {
+        cf->family = FUNC_POLY; cf->eval = evalPolyKernel;
+        cf->a4 = customPoly.a4; cf->a3 = customPoly.a3; cf->a2 = customPoly.a2;
+        cf->a1 = customPoly.a1; cf->a0 = customPoly.a0;
+    }
+
+    optimizeFunction(cf);
+    return cf->family != FUNC_INTERPRETED;
+}
+
+// Evaluates n samples at once. Each family gets its own loop over static
+// kernels, so the compiler can inline them and there is no indirect call per x.
+void evaluateCompiledBatch(const CompiledFunction *cf, const double *x, double *y, int n) {
+    int i;
+    switch (cf->family) {
+    case FUNC_SIN:  evalSinBatch(cf, x, y, n); break;
+    case FUNC_COS:  evalCosBatch(cf, x, y, n); break;
+    case FUNC_TAN:  evalTanBatch(cf, x, y, n); break;
+    case FUNC_ASIN: evalASinBatch(cf, x, y, n); break;
+    case FUNC_ACOS: evalACosBatch(cf, x, y, n); break;
+    case FUNC_ATAN: evalATanBatch(cf, x, y, n); break;
+    case FUNC_EXP:  evalExpBatch(cf, x, y, n); break;
+    case FUNC_LOG:  evalLogBatch(cf, x, y, n); break;
+    case FUNC_LN:   evalLnBatch(cf, x, y, n); break;
+    case FUNC_POLY:
+        switch (cf->degree) {   // the Horner chain optimizeFunction picked
+        case 0:  for (i = 0; i < n; i++) y[i] = evalPoly0Kernel(cf, x[i]); break;
+        case 1:  for (i = 0; i < n; i++) y[i] = evalPoly1Kernel(cf, x[i]); break;
+        case 2:  for (i = 0; i < n; i++) y[i] = evalPoly2Kernel(cf, x[i]); break;
+        case 3:  for (i = 0; i < n; i++) y[i] = evalPoly3Kernel(cf, x[i]); break;
+        default: for (i = 0; i < n; i++) y[i] = evalPolyKernel(cf, x[i]); break;
+        }
+        break;
+    case FUNC_CONSTANT: for (i = 0; i < n; i++) y[i] = cf->D; break;
+    default:        for (i = 0; i < n; i++) y[i] = cf->eval(cf, x[i]); break;
+    }
+}
+
+// Value and first two derivatives of a function at one point, carried
+// together through the chain rule (second-order forward-mode dual number).
+typedef struct {
+    double v, d1, d2;
+} Jet;
+
+// w = f(u) given f, f' and f'' evaluated at u.v
+static Jet jetApply(Jet u, double f0, double f1, double f2) {
+    Jet w;
+    w.v = f0;
+    w.d1 = f1 * u.d1;
+    w.d2 = f2 * u.d1 * u.d1 + f1 * u.d2;
+    return w;
+}
+
+static Jet jetUndefined() {
+    Jet w = {INFINITY, INFINITY, INFINITY};
+    return w;
+}
+
+// Evaluates f, f' and f'' of a compiled function in a single pass
+Jet evaluateCompiledJet(const CompiledFunction *cf, double x) {
+    Jet u = {cf->B * x + cf->C, cf->B, 0};
+    Jet w;
+    double s, c, t, q;
+
+    switch (cf->family) {
+    case FUNC_CONSTANT: {
+        Jet k = {cf->D, 0, 0};
+        return k;
+    }
+    case FUNC_POLY: {
+        // Horner's scheme extended to carry p' and p''
+        double coefficients[4] = {cf->a3, cf->a2, cf->a1, cf->a0};
+        Jet p = {cf->a4, 0, 0};
+        for (int i = 0; i < 4; i++) {
+            p.d2 = p.d2 * x + 2 * p.d1;
+            p.d1 = p.d1 * x + p.v;
+            p.v = p.v * x + coefficients[i];
+        }
+        return p;
+    }
+    case FUNC_SIN:
+        s = sin(u.v); c = cos(u.v);
+        w = jetApply(u, s, c, -s);
+        break;
+    case FUNC_COS:
+        s = sin(u.v); c = cos(u.v);
+        w = jetApply(u, c, -s, -c);
+        break;
+    case FUNC_TAN:
+        t = tan(u.v);
+        w = jetApply(u, t, 1 + t * t, 2 * t * (1 + t * t));
+        break;
+    case FUNC_ASIN:
+    case FUNC_ACOS:
+        if (u.v < -1 || u.v > 1) return jetUndefined();
+        q = 1 - u.v * u.v;
+        w = jetApply(u, asin(u.v), 1 / sqrt(q), u.v / (q * sqrt(q)));
+        if (cf->family == FUNC_ACOS) {
+            // acos'(u) = -asin'(u)
+            w.v = acos(u.v); w.d1 = -w.d1; w.d2 = -w.d2;
+        }
+        break;
+    case FUNC_ATAN:
+        q = 1 + u.v * u.v;
+        w = jetApply(u, atan(u.v), 1 / q, -2 * u.v / (q * q));
+        break;
+    case FUNC_EXP:
+        t = exp(u.v);
+        w = jetApply(u, t, t, t);
+        break;
+    case FUNC_LOG:
+        if (u.v <= 0) return jetUndefined();
+        w = jetApply(u, log10(u.v), 1 / (u.v * M_LN10), -1 / (u.v * u.v * M_LN10));
+        break;
+    case FUNC_LN:
+        if (u.v <= 0) return jetUndefined();
+        w = jetApply(u, log(u.v), 1 / u.v, -1 / (u.v * u.v));
+        break;
+    default: {
+        // Unknown name: nothing to differentiate symbolically, use central differences
+        double h = 1e-4;
+        double f0 = cf->eval(cf, x);
+        double fp = cf->eval(cf, x + h);
+        double fm = cf->eval(cf, x - h);
+        Jet d = {f0, (fp - fm) / (2 * h), (fp - 2 * f0 + fm) / (h * h)};
+        return d;
+    }
+    }
+
+    w.v = cf->A * w.v + cf->D;
+    w.d1 *= cf->A;
+    w.d2 *= cf->A;
+    return w;
+}
+
+// Newton's method from x0 using the exact derivative. Returns 1 and stores
+// the root when the iteration converges.
+int refineRoot(const CompiledFunction *cf, double x0, double *root) {
+    double x = x0;
+    for (int i = 0; i < NEWTON_MAX_ITERATIONS; i++) {
+        Jet f = evaluateCompiledJet(cf, x);
+        if (!isfinite(f.v) || !isfinite(f.d1) || f.d1 == 0) return 0;
+        double dx = f.v / f.d1;
+        x -= dx;
+        if (fabs(dx) <= 1e-12 * (1 + fabs(x))) {
+            *root = x;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Picks the next sampling step from the local screen-space curvature so that
+// a straight segment never strays more than CHORD_TOLERANCE pixels from the
+// curve: for a circle of curvature k a chord of length L has sagitta L*L*k/8.
+static double curvatureStep(Jet f, double minStep, double maxStep) {
+    if (!isfinite(f.d1) || !isfinite(f.d2)) return minStep;
+
+    double slope = f.d1 * scaleY / scaleX;
+    double bend = f.d2 * scaleY / (scaleX * scaleX);
+    double stretch = sqrt(1 + slope * slope);
+    double curvature = fabs(bend) / (stretch * stretch * stretch);
+
+    double h = maxStep;
+    if (curvature > 0) {
+        double chord = sqrt(8 * CHORD_TOLERANCE / curvature);
+        h = chord / (scaleX * stretch);
+    }
+    if (h < minStep) h = minStep;
+    if (h > maxStep) h = maxStep;
+    return h;
+}
+
+// f' in a dimmed version of the curve's color, one sample per pixel
+static void plotDerivative(const CompiledFunction *cf, double r, double g, double b,
+                           double startX, double endX, double originX, double originY) {
+    iSetColor(r / 2, g / 2, b / 2);
+    double h = 1 / scaleX;
+    Jet j1 = evaluateCompiledJet(cf, startX);
+    for (double x = startX; x <= endX; x += h) {
+        Jet j2 = evaluateCompiledJet(cf, x + h);
+        double y1 = j1.d1, y2 = j2.d1;
+        j1 = j2;
+
+        if (!isfinite(y1) || !isfinite(y2)) continue;
+        if (fabs(y1) > 1e5 || fabs(y2) > 1e5) continue;
+
+        double screenY1 = originY + y1 * scaleY;
+        double screenY2 = originY + y2 * scaleY;
+        if ((screenY1 < 0 || screenY1 > WINDOW_HEIGHT) && (screenY2 < 0 || screenY2 > WINDOW_HEIGHT)) continue;
+
+        iLine(originX + x * scaleX, screenY1, originX + (x + h) * scaleX, screenY2);
+    }
+}
+
+// Tangent line at the probe, plus the nearest root Newton converges to
+static void plotTangent(const CompiledFunction *cf, double r, double g, double b,
+                        double startX, double endX, double originX, double originY) {
+    Jet t = evaluateCompiledJet(cf, tangentX);
+    if (!isfinite(t.v) || !isfinite(t.d1) || fabs(t.v) > 1e5) return;
+
     iSetColor(r, g, b);
-    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
-    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+    iLine(originX + startX * scaleX, originY + (t.v + t.d1 * (startX - tangentX)) * scaleY,
+          originX + endX * scaleX, originY + (t.v + t.d1 * (endX - tangentX)) * scaleY);
 
-    for (double x = startX; x <= endX; x += step) {
-        double y1 = evaluateFunction(x, func);
-        double y2 = evaluateFunction(x + step, func);
+    double px = originX + tangentX * scaleX;
+    double py = originY + t.v * scaleY;
+    iFilledCircle(px, py, 3);
+
+    char label[80];
+    snprintf(label, sizeof(label), "y=%.3f y'=%.3f y''=%.3f", t.v, t.d1, t.d2);
+    iText(px + 6, py + 6, label);
+
+    double root;
+    if (refineRoot(cf, tangentX, &root) && root >= startX && root <= endX) {
+        iCircle(originX + root * scaleX, originY, 4);
+        snprintf(label, sizeof(label), "root %.6f", root);
+        iText(originX + root * scaleX + 6, originY - 16, label);
+    }
+}
+
+// Curves are sampled in world coordinates into a display list covering three
+// windows each way around the view, then placed on screen with glTranslate /
+// glScale. Panning inside that area reuses the list as it is; the curve is
+// sampled again only when its definition changes, the view leaves the covered
+// area, or the zoom drifts far enough from the sampled one to change the steps.
+#define MAX_RETAINED_CURVES 16
+#define RESAMPLE_ZOOM_RATIO 1.5
+
+typedef struct {
+    char name[MAX_SHAPE_NAME];
+    bool valid;
+    CompiledFunction cf;        // definition the list was sampled from
+    double scaleX, scaleY;      // zoom it was sampled at
+    double x0, x1, y0, y1;      // world rectangle the list covers
+    GLuint list;
+} RetainedCurve;
+
+RetainedCurve retainedCurves[MAX_RETAINED_CURVES];
+int retainedCurveCount = 0;
+
+static RetainedCurve *findRetainedCurve(const char *func) {
+    for (int i = 0; i < retainedCurveCount; i++) {
+        if (strcmp(retainedCurves[i].name, func) == 0) return &retainedCurves[i];
+    }
+    if (retainedCurveCount == MAX_RETAINED_CURVES) return NULL;
+
+    RetainedCurve *rc = &retainedCurves[retainedCurveCount++];
+    memset(rc, 0, sizeof(*rc));
+    strncpy(rc->name, func, MAX_SHAPE_NAME - 1);
+    return rc;
+}
+
+static bool sameDefinition(const CompiledFunction *a, const CompiledFunction *b) {
+    return a->family == b->family && a->shape == b->shape && a->degree == b->degree &&
+           a->A == b->A && a->B == b->B && a->C == b->C && a->D == b->D &&
+           a->a4 == b->a4 && a->a3 == b->a3 && a->a2 == b->a2 && a->a1 == b->a1 && a->a0 == b->a0 &&
+           strcmp(a->name, b->name) == 0;
+}
+
+static bool withinZoom(double sampled, double current) {
+    double ratio = current / sampled;
+    return ratio <= RESAMPLE_ZOOM_RATIO && ratio >= 1 / RESAMPLE_ZOOM_RATIO;
+}
+
+// A segment whose rise runs against the slope at both of its ends, and is
+// taller than the window, jumps across a pole rather than following the curve
+static bool crossesPole(Jet j1, Jet j2) {
+    double rise = j2.v - j1.v;
+    if (fabs(rise) * scaleY <= WINDOW_HEIGHT) return false;
+    return rise * j1.d1 < 0 || rise * j2.d1 < 0;
+}
+
+static void sampleRetainedCurve(RetainedCurve *rc, const CompiledFunction *cf,
+                                double startX, double endX, double startY, double endY) {
+    double width = endX - startX;
+    double height = endY - startY;
+    rc->x0 = startX - width;
+    rc->x1 = endX + width;
+    rc->y0 = startY - height;
+    rc->y1 = endY + height;
+    rc->cf = *cf;
+    rc->scaleX = scaleX;
+    rc->scaleY = scaleY;
+
+    // Flat stretches are covered with long segments and tight bends with
+    // short ones; `step` is kept as the finest resolution the zoom allows.
+    double maxStep = MAX_SEGMENT_PIXELS / scaleX;
+    if (maxStep < step) maxStep = step;
+
+    glNewList(rc->list, GL_COMPILE);
+    glBegin(GL_LINES);
+
+    // Each segment's right end is the next segment's left end, so carry it
+    // over instead of evaluating every abscissa twice.
+    double x = rc->x0;
+    Jet j1 = evaluateCompiledJet(cf, x);
+    while (x <= rc->x1) {
+        double h = curvatureStep(j1, step, maxStep);
+        Jet j2 = evaluateCompiledJet(cf, x + h);
+        double y1 = j1.v, y2 = j2.v;
+        double x1 = x;
+        x += h;
+        Jet left = j1;
+        j1 = j2;
 
         if (!isfinite(y1) || !isfinite(y2)) {
             continue;
@@ -1084,17 +1463,50 @@ void plotFunction(const char* func, double r, double g, double b) {
         if (fabs(y1) > 1e5 || fabs(y2) > 1e5) {
             continue;
         }
+        if ((y1 < rc->y0 || y1 > rc->y1) && (y2 < rc->y0 || y2 > rc->y1)) continue;
+        if (crossesPole(left, j2)) continue;
 
-        double screenX1 = WINDOW_WIDTH / 2 + (x + offsetX) * scaleX;
-        double screenY1 = WINDOW_HEIGHT / 2 + (y1 + offsetY) * scaleY;
-        double screenX2 = WINDOW_WIDTH / 2 + (x + step + offsetX) * scaleX;
-        double screenY2 = WINDOW_HEIGHT / 2 + (y2 + offsetY) * scaleY;
+        glVertex2d(x1, y1);
+        glVertex2d(x, y2);
+    }
 
-        if ((screenX1 < 0 || screenX1 > WINDOW_WIDTH) && (screenX2 < 0 || screenX2 > WINDOW_WIDTH)) continue;
-        if ((screenY1 < 0 || screenY1 > WINDOW_HEIGHT) && (screenY2 < 0 || screenY2 > WINDOW_HEIGHT)) continue;
+    glEnd();
+    glEndList();
+    rc->valid = true;
+}
 
-        iLine(screenX1, screenY1, screenX2, screenY2);
+void plotFunction(const char* func, double r, double g, double b) {
+    iSetColor(r, g, b);
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+    double startY = -offsetY - (WINDOW_HEIGHT / 2) / scaleY;
+    double endY = -offsetY + (WINDOW_HEIGHT / 2) / scaleY;
+
+    CompiledFunction cf;
+    compileFunction(func, &cf);
+
+    // The screen transform does not depend on x; hoist its constant part
+    double originX = WINDOW_WIDTH / 2 + offsetX * scaleX;
+    double originY = WINDOW_HEIGHT / 2 + offsetY * scaleY;
+
+    RetainedCurve *rc = findRetainedCurve(func);
+    if (rc != NULL && rc->list == 0) rc->list = glGenLists(1);
+    if (rc == NULL || rc->list == 0) return;
+
+    if (!rc->valid || !sameDefinition(&rc->cf, &cf) ||
+        !withinZoom(rc->scaleX, scaleX) || !withinZoom(rc->scaleY, scaleY) ||
+        startX < rc->x0 || endX > rc->x1 || startY < rc->y0 || endY > rc->y1) {
+        sampleRetainedCurve(rc, &cf, startX, endX, startY, endY);
     }
+
+    glPushMatrix();
+    glTranslated(originX, originY, 0);
+    glScaled(scaleX, scaleY, 1);
+    glCallList(rc->list);
+    glPopMatrix();
+
+    if (showDerivatives) plotDerivative(&cf, r, g, b, startX, endX, originX, originY);
+    if (showTangent) plotTangent(&cf, r, g, b, startX, endX, originX, originY);
 }
 
 // Plot Circle with dynamic color
@@ -1153,50 +1565,517 @@ void plotParabola(double r, double g, double b) {
         double screenX2 = WINDOW_WIDTH / 2 + (x + step + offsetX) * scaleX;
         double screenY2 = WINDOW_HEIGHT / 2 + (y2 + offsetY) * scaleY;
 
-        if ((screenX1 < 0 || screenX1 > WINDOW_WIDTH) && (screenX2 < 0 || screenX2 > WINDOW_WIDTH)) continue;
-        if ((screenY1 < 0 || screenY1 > WINDOW_HEIGHT) && (screenY2 < 0 || screenY2 > WINDOW_HEIGHT)) continue;
+        if ((screenX1 < 0 || screenX1 > WINDOW_WIDTH) && (screenX2 < 0 || screenX2 > WINDOW_WIDTH)) continue;
+        if ((screenY1 < 0 || screenY1 > WINDOW_HEIGHT) && (screenY2 < 0 || screenY2 > WINDOW_HEIGHT)) continue;
+
+        iLine(screenX1, screenY1, screenX2, screenY2);
+    }
+}
+
+// Plot Hyperbola with dynamic color
+void plotHyperbola(double r, double g, double b) {
+    iSetColor(r, g, b);
+    float h = customHyperbola.h;
+    float k = customHyperbola.k;
+    float a = customHyperbola.a * scaleX;
+    float b_axis = customHyperbola.b * scaleY;
+
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX - h - 10;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX - h + 10;
+
+    for (double x = startX; x <= endX; x += step) {
+        double denominator = (x / a) * (x / a) - 1;
+        if (denominator <= 0) continue;
+
+        double y1 = k + b_axis * sqrt(denominator);
+        double y2 = k + b_axis * sqrt(((x + step) / a) * ((x + step) / a) - 1);
+
+        double y3 = k - b_axis * sqrt(denominator);
+        double y4 = k - b_axis * sqrt(((x + step) / a) * ((x + step) / a) - 1);
+
+        if (isfinite(y1) && isfinite(y2)) {
+            double screenX1 = WINDOW_WIDTH / 2 + (x + offsetX) * scaleX;
+            double screenY1 = WINDOW_HEIGHT / 2 + (y1 + offsetY) * scaleY;
+            double screenX2 = WINDOW_WIDTH / 2 + (x + step + offsetX) * scaleX;
+            double screenY2 = WINDOW_HEIGHT / 2 + (y2 + offsetY) * scaleY;
+            iLine(screenX1, screenY1, screenX2, screenY2);
+        }
+
+        if (isfinite(y3) && isfinite(y4)) {
+            double screenX1 = WINDOW_WIDTH / 2 + (x + offsetX) * scaleX;
+            double screenY1 = WINDOW_HEIGHT / 2 + (y3 + offsetY) * scaleY;
+            double screenX2 = WINDOW_WIDTH / 2 + (x + step + offsetX) * scaleX;
+            double screenY2 = WINDOW_HEIGHT / 2 + (y4 + offsetY) * scaleY;
+            iLine(screenX1, screenY1, screenX2, screenY2);
+        }
+    }
+}
+
+// Measured (x, y) data drawn over the curves. A CSV file is converted once
+// into a columnar .pts file next to it: a DataHeader, every x, every y, then
+// a min/max pyramid over y. The .pts file is mapped read-only, so opening and
+// panning a large series touches only the pages the view needs. Rows must be
+// sorted by x.
+typedef struct {
+    char magic[4];              // "PTS1"
+    int levels;                 // pyramid levels stored after the columns
+    long long count;            // rows
+    double minX, maxX, minY, maxY;
+} DataHeader;
+
+typedef struct {
+    bool loaded;
+    HANDLE file, mapping;
+    const char *view;
+    const DataHeader *header;
+    const double *x, *y;
+    const double *level[DATA_MAX_LEVELS];   // (min y, max y) per bucket of 2^(DATA_BASE_SHIFT + k) rows
+} DataSeries;
+
+DataSeries dataSeries;
+char dataError[100] = "";
+
+static long long dataLevelCount(long long count, int k) {
+    int shift = DATA_BASE_SHIFT + k;
+    return (count + (1LL << shift) - 1) >> shift;
+}
+
+static void unloadDataSeries(DataSeries *ds) {
+    if (ds->view != NULL) UnmapViewOfFile(ds->view);
+    if (ds->mapping != NULL) CloseHandle(ds->mapping);
+    if (ds->file != NULL && ds->file != INVALID_HANDLE_VALUE) CloseHandle(ds->file);
+    memset(ds, 0, sizeof(*ds));
+}
+
+static bool mapDataFile(const char *path, DataSeries *ds, long long *size) {
+    ds->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (ds->file == INVALID_HANDLE_VALUE) return false;
+    DWORD high;
+    DWORD low = GetFileSize(ds->file, &high);
+    *size = ((long long)high << 32) | low;
+    if (*size == 0) return false;
+    ds->mapping = CreateFileMappingA(ds->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (ds->mapping == NULL) return false;
+    ds->view = (const char *)MapViewOfFile(ds->mapping, FILE_MAP_READ, 0, 0, 0);
+    return ds->view != NULL;
+}
+
+// Reads "x,y" from one line; comma, semicolon, tab or space separate the
+// fields. Header and blank lines are rejected and skipped by the caller.
+static bool parseDataRow(const char *line, double *x, double *y) {
+    char *end;
+    *x = strtod(line, &end);
+    if (end == line) return false;
+    const char *p = end;
+    while (*p == ' ' || *p == '\t' || *p == ',' || *p == ';') p++;
+    *y = strtod(p, &end);
+    if (end == p) return false;
+    return isfinite(*x) && isfinite(*y);
+}
+
+// Writes the .pts file for a CSV in one pass: x goes straight to the output,
+// y to a side file that is appended afterwards while the first pyramid level
+// is built from it.
+static bool convertCsvToPoints(const char *csvPath, const char *ptsPath) {
+    DataSeries csv;
+    long long size;
+    memset(&csv, 0, sizeof(csv));
+    if (!mapDataFile(csvPath, &csv, &size)) {
+        unloadDataSeries(&csv);
+        strcpy(dataError, "Cannot open the CSV file");
+        return false;
+    }
+
+    char yPath[MAX_INPUT_LENGTH + 8];
+    sprintf(yPath, "%s.y", ptsPath);
+    FILE *out = fopen(ptsPath, "wb");
+    FILE *ys = fopen(yPath, "w+b");
+    if (out == NULL || ys == NULL) {
+        if (out != NULL) fclose(out);
+        if (ys != NULL) fclose(ys);
+        unloadDataSeries(&csv);
+        strcpy(dataError, "Cannot write the converted file");
+        return false;
+    }
+
+    DataHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "PTS1", 4);
+    fwrite(&header, sizeof(header), 1, out);
+
+    bool ok = true;
+    long long pos = 0;
+    while (pos < size) {
+        // Copy the line out of the view: strtod must not run past its end
+        char line[256];
+        int len = 0;
+        while (pos < size && csv.view[pos] != '\n') {
+            if (len < (int)sizeof(line) - 1) line[len++] = csv.view[pos];
+            pos++;
+        }
+        pos++;
+        line[len] = '\0';
+
+        double x, y;
+        if (!parseDataRow(line, &x, &y)) continue;
+        if (header.count > 0 && x < header.maxX) {
+            strcpy(dataError, "Rows must be sorted by x");
+            ok = false;
+            break;
+        }
+        if (header.count == 0) {
+            header.minX = x;
+            header.minY = header.maxY = y;
+        }
+        header.maxX = x;
+        if (y < header.minY) header.minY = y;
+        if (y > header.maxY) header.maxY = y;
+        header.count++;
+        fwrite(&x, sizeof(double), 1, out);
+        fwrite(&y, sizeof(double), 1, ys);
+    }
+    unloadDataSeries(&csv);
+    if (ok && header.count == 0) {
+        strcpy(dataError, "No x,y rows in the file");
+        ok = false;
+    }
+
+    // y column, with the finest pyramid level gathered on the way
+    double *levels[DATA_MAX_LEVELS];
+    memset(levels, 0, sizeof(levels));
+    if (ok) {
+        levels[0] = (double *)malloc(dataLevelCount(header.count, 0) * 2 * sizeof(double));
+        ok = levels[0] != NULL;
+        if (!ok) strcpy(dataError, "Not enough memory to index the data");
+    }
+    if (ok) {
+        double chunk[4096];
+        long long row = 0;
+        size_t n;
+        rewind(ys);
+        while ((n = fread(chunk, sizeof(double), 4096, ys)) > 0) {
+            fwrite(chunk, sizeof(double), n, out);
+            for (size_t i = 0; i < n; i++, row++) {
+                double *bucket = levels[0] + 2 * (row >> DATA_BASE_SHIFT);
+                if ((row & ((1 << DATA_BASE_SHIFT) - 1)) == 0 || chunk[i] < bucket[0]) bucket[0] = chunk[i];
+                if ((row & ((1 << DATA_BASE_SHIFT) - 1)) == 0 || chunk[i] > bucket[1]) bucket[1] = chunk[i];
+            }
+        }
+
+        // Each coarser level merges pairs of buckets from the one below
+        header.levels = 1;
+        while (header.levels < DATA_MAX_LEVELS && dataLevelCount(header.count, header.levels - 1) > 1) {
+            int k = header.levels;
+            long long count = dataLevelCount(header.count, k);
+            long long below = dataLevelCount(header.count, k - 1);
+            levels[k] = (double *)malloc(count * 2 * sizeof(double));
+            if (levels[k] == NULL) break;
+            for (long long b = 0; b < count; b++) {
+                const double *a = levels[k - 1] + 4 * b;
+                levels[k][2 * b] = a[0];
+                levels[k][2 * b + 1] = a[1];
+                if (2 * b + 1 < below) {
+                    if (a[2] < a[0]) levels[k][2 * b] = a[2];
+                    if (a[3] > a[1]) levels[k][2 * b + 1] = a[3];
+                }
+            }
+            header.levels++;
+        }
+        for (int k = 0; k < header.levels; k++) {
+            fwrite(levels[k], sizeof(double), dataLevelCount(header.count, k) * 2, out);
+        }
+        rewind(out);
+        fwrite(&header, sizeof(header), 1, out);
+    }
+    for (int k = 0; k < DATA_MAX_LEVELS; k++) free(levels[k]);
+
+    ok = ok && !ferror(out);
+    fclose(out);
+    fclose(ys);
+    remove(yPath);
+    if (!ok) {
+        if (dataError[0] == '\0') strcpy(dataError, "Cannot write the converted file");
+        remove(ptsPath);
+    }
+    return ok;
+}
+
+// Opens a .pts file, converting "name.csv" to "name.csv.pts" first if that
+// has not been done yet. Delete the .pts file to pick up a changed CSV.
+int loadDataSeries(const char *path, DataSeries *ds) {
+    char ptsPath[MAX_INPUT_LENGTH + 8];
+    int len = strlen(path);
+    dataError[0] = '\0';
+    unloadDataSeries(ds);
+
+    if (len > 4 && strcmp(path + len - 4, ".csv") == 0) {
+        sprintf(ptsPath, "%s.pts", path);
+        FILE *existing = fopen(ptsPath, "rb");
+        if (existing != NULL) {
+            fclose(existing);
+        } else if (!convertCsvToPoints(path, ptsPath)) {
+            return 0;
+        }
+    } else {
+        strcpy(ptsPath, path);
+    }
+
+    long long size;
+    if (!mapDataFile(ptsPath, ds, &size) || size < (long long)sizeof(DataHeader)) {
+        unloadDataSeries(ds);
+        strcpy(dataError, "Cannot open the data file");
+        return 0;
+    }
+
+    const DataHeader *header = (const DataHeader *)ds->view;
+    long long expected = sizeof(DataHeader) + header->count * 2 * sizeof(double);
+    for (int k = 0; k < header->levels && k < DATA_MAX_LEVELS; k++) {
+        expected += dataLevelCount(header->count, k) * 2 * sizeof(double);
+    }
+    if (memcmp(header->magic, "PTS1", 4) != 0 || header->count <= 0 ||
+        header->levels < 1 || header->levels > DATA_MAX_LEVELS || size < expected) {
+        unloadDataSeries(ds);
+        strcpy(dataError, "Not a valid .pts data file");
+        return 0;
+    }
+
+    ds->header = header;
+    ds->x = (const double *)(ds->view + sizeof(DataHeader));
+    ds->y = ds->x + header->count;
+    const double *level = ds->y + header->count;
+    for (int k = 0; k < header->levels; k++) {
+        ds->level[k] = level;
+        level += dataLevelCount(header->count, k) * 2;
+    }
+    ds->loaded = true;
+    return 1;
+}
+
+// First row whose x is not below value
+static long long dataLowerBound(const DataSeries *ds, double value) {
+    long long lo = 0, hi = ds->header->count;
+    while (lo < hi) {
+        long long mid = lo + (hi - lo) / 2;
+        if (ds->x[mid] < value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Draws the rows in view from the coarsest pyramid level that still gives
+// about one bucket per pixel column, each bucket as a min-max stroke
+void plotDataSeries(const DataSeries *ds, double r, double g, double b) {
+    if (!ds->loaded) return;
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+
+    long long count = ds->header->count;
+    long long first = dataLowerBound(ds, startX);
+    long long last = dataLowerBound(ds, endX);
+    if (first > 0) first--;     // keep the segments that cross the window edges
+    if (last < count) last++;
+    long long rows = last - first;
+    if (rows <= 0) return;
+
+    iSetColor(r, g, b);
+    glPushMatrix();
+    glTranslated(WINDOW_WIDTH / 2 + offsetX * scaleX, WINDOW_HEIGHT / 2 + offsetY * scaleY, 0);
+    glScaled(scaleX, scaleY, 1);
+    glBegin(GL_LINE_STRIP);
+    if (rows <= 2 * WINDOW_WIDTH) {
+        for (long long i = first; i < last; i++) glVertex2d(ds->x[i], ds->y[i]);
+    } else {
+        int k = 0;
+        while (k < ds->header->levels - 1 && (rows >> (DATA_BASE_SHIFT + k)) > 2 * WINDOW_WIDTH) k++;
+        int shift = DATA_BASE_SHIFT + k;
+        const double *level = ds->level[k];
+        for (long long bucket = first >> shift; bucket <= (last - 1) >> shift; bucket++) {
+            double x = ds->x[bucket << shift];
+            glVertex2d(x, level[2 * bucket]);
+            glVertex2d(x, level[2 * bucket + 1]);
+        }
+    }
+    glEnd();
+    glPopMatrix();
+}
+
+// Live points read from stdin ("-") or a named pipe by a background thread.
+// Each line holds "x,y" (same separators as data files) or a lone y, which is
+// plotted against its sample number. The reader appends to a ring of the
+// newest STREAM_CAPACITY points and publishes them once per read, so the
+// drawing thread never waits on I/O. Only the newest half of the ring is
+// drawn, leaving the reader room to keep writing while a frame is drawn.
+typedef struct {
+    double x, y;
+} StreamPoint;
 
-        iLine(screenX1, screenY1, screenX2, screenY2);
+typedef struct {
+    volatile LONG running;      // cleared by the reader thread when the source closes
+    HANDLE source;
+    bool isPipe;
+    StreamPoint *ring;
+    volatile LONG head;         // ring index of the next point; only the reader thread stores it
+    volatile LONG filled;       // set once head has wrapped, so every slot holds a point
+    double samples;             // x for lines that hold only y
+} StreamState;
+
+StreamState stream;
+bool streamFollow = true;       // keep the newest point at the right edge
+
+// Parses one line and stores it in the ring slot at head, without publishing it
+static bool readStreamLine(const char *line, LONG head) {
+    StreamPoint *p = &stream.ring[head];
+    if (parseDataRow(line, &p->x, &p->y)) return true;
+
+    char *end;
+    p->y = strtod(line, &end);
+    if (end == line || !isfinite(p->y)) return false;
+    p->x = stream.samples;
+    stream.samples += 1;
+    return true;
+}
+
+DWORD WINAPI streamReader(LPVOID) {
+    static char buffer[65536];
+    char line[256];
+    int len = 0;
+    LONG head = 0;
+
+    for (;;) {
+        // A writer that connected before we waited is reported as
+        // ERROR_PIPE_CONNECTED; any other failure means the pipe is unusable
+        if (stream.isPipe && !ConnectNamedPipe(stream.source, NULL) && GetLastError() != ERROR_PIPE_CONNECTED) break;
+
+        DWORD got;
+        while (ReadFile(stream.source, buffer, sizeof(buffer), &got, NULL) && got > 0) {
+            for (DWORD i = 0; i < got; i++) {
+                char c = buffer[i];
+                if (c != '\n') {
+                    if (len < (int)sizeof(line) - 1) line[len++] = c;
+                    continue;
+                }
+                line[len] = '\0';
+                len = 0;
+                if (!readStreamLine(line, head)) continue;
+                head = (head + 1) & (STREAM_CAPACITY - 1);
+                if (head == 0) InterlockedExchange(&stream.filled, 1);
+            }
+            InterlockedExchange(&stream.head, head);
+        }
+        if (!stream.isPipe) break;
+        DisconnectNamedPipe(stream.source);     // wait for the next writer
     }
+    if (stream.isPipe) CloseHandle(stream.source);
+    InterlockedExchange(&stream.running, 0);    // 'i' can start a new stream now
+    return 0;
 }
 
-// Plot Hyperbola with dynamic color
-void plotHyperbola(double r, double g, double b) {
-    iSetColor(r, g, b);
-    float h = customHyperbola.h;
-    float k = customHyperbola.k;
-    float a = customHyperbola.a * scaleX;
-    float b_axis = customHyperbola.b * scaleY;
+// source is "-" for stdin or a pipe name such as "sensor" (\\.\pipe\sensor)
+int startStream(const char *source) {
+    if (stream.running) {
+        strcpy(dataError, "A stream is already running");
+        return 0;
+    }
+    dataError[0] = '\0';
 
-    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX - h - 10;
-    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX - h + 10;
+    if (stream.ring == NULL) stream.ring = (StreamPoint *)malloc(STREAM_CAPACITY * sizeof(StreamPoint));
+    if (stream.ring == NULL) {
+        strcpy(dataError, "Not enough memory for the stream");
+        return 0;
+    }
 
-    for (double x = startX; x <= endX; x += step) {
-        double denominator = (x / a) * (x / a) - 1;
-        if (denominator <= 0) continue;
+    if (strcmp(source, "-") == 0) {
+        stream.source = GetStdHandle(STD_INPUT_HANDLE);
+        stream.isPipe = false;
+    } else {
+        char name[MAX_INPUT_LENGTH + 16];
+        sprintf(name, "\\\\.\\pipe\\%s", source);
+        stream.source = CreateNamedPipeA(name, PIPE_ACCESS_INBOUND, PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT,
+                                         1, 0, 65536, 0, NULL);
+        stream.isPipe = true;
+    }
+    if (stream.source == NULL || stream.source == INVALID_HANDLE_VALUE) {
+        strcpy(dataError, "Cannot open the stream source");
+        return 0;
+    }
+
+    stream.head = 0;
+    stream.filled = 0;
+    stream.samples = 0;
+    stream.running = 1;     // set first: a source that is already at its end clears it at once
+    HANDLE thread = CreateThread(NULL, 0, streamReader, NULL, 0, NULL);
+    if (thread == NULL) {
+        if (stream.isPipe) CloseHandle(stream.source);
+        stream.running = 0;
+        strcpy(dataError, "Cannot start the stream reader");
+        return 0;
+    }
+    CloseHandle(thread);
+    streamFollow = true;
+    return 1;
+}
 
-        double y1 = k + b_axis * sqrt(denominator);
-        double y2 = k + b_axis * sqrt(((x + step) / a) * ((x + step) / a) - 1);
+// Ring index of the newest streamed point and how many points up to it may be
+// drawn; false while nothing has arrived. The reader sets filled before it
+// publishes the head that wrapped, so head is read first.
+static bool streamWindow(LONG *newest, LONG *available) {
+    LONG head = stream.head;
+    bool filled = stream.filled != 0;
+    if (head == 0 && !filled) return false;
+    *newest = (head - 1) & (STREAM_CAPACITY - 1);
+    *available = (filled || head > STREAM_CAPACITY / 2) ? STREAM_CAPACITY / 2 : head;
+    return true;
+}
 
-        double y3 = k - b_axis * sqrt(denominator);
-        double y4 = k - b_axis * sqrt(((x + step) / a) * ((x + step) / a) - 1);
+// Puts the newest point at the right edge. iDraw calls this before drawing
+// anything, so the grid and curves share the stream's offset for the frame.
+void followStream() {
+    LONG newest, available;
+    if (!showStream || !streamFollow || !streamWindow(&newest, &available)) return;
+    offsetX = -stream.ring[newest].x + (WINDOW_WIDTH / 2 - STREAM_FOLLOW_MARGIN) / scaleX;
+}
 
-        if (isfinite(y1) && isfinite(y2)) {
-            double screenX1 = WINDOW_WIDTH / 2 + (x + offsetX) * scaleX;
-            double screenY1 = WINDOW_HEIGHT / 2 + (y1 + offsetY) * scaleY;
-            double screenX2 = WINDOW_WIDTH / 2 + (x + step + offsetX) * scaleX;
-            double screenY2 = WINDOW_HEIGHT / 2 + (y2 + offsetY) * scaleY;
-            iLine(screenX1, screenY1, screenX2, screenY2);
-        }
+// Newest points, reduced to a min-max stroke per pixel column
+void plotStream(double r, double g, double b) {
+    static double columnMin[WINDOW_WIDTH], columnMax[WINDOW_WIDTH], columnX[WINDOW_WIDTH];
+    static bool columnUsed[WINDOW_WIDTH];
 
-        if (isfinite(y3) && isfinite(y4)) {
-            double screenX1 = WINDOW_WIDTH / 2 + (x + offsetX) * scaleX;
-            double screenY1 = WINDOW_HEIGHT / 2 + (y3 + offsetY) * scaleY;
-            double screenX2 = WINDOW_WIDTH / 2 + (x + step + offsetX) * scaleX;
-            double screenY2 = WINDOW_HEIGHT / 2 + (y4 + offsetY) * scaleY;
-            iLine(screenX1, screenY1, screenX2, screenY2);
+    LONG newest, available;
+    if (!streamWindow(&newest, &available)) return;
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+
+    // x need not grow (scattered rows, a new writer starting over at 0), so
+    // every drawable point is checked; available caps the scan at half the ring
+    memset(columnUsed, 0, sizeof(columnUsed));
+    for (LONG i = 0; i < available; i++) {
+        const StreamPoint *p = &stream.ring[(newest - i) & (STREAM_CAPACITY - 1)];
+        if (p->x < startX || p->x > endX) continue;
+
+        int column = (int)((p->x - startX) * scaleX);
+        if (column < 0 || column >= WINDOW_WIDTH) continue;
+        if (!columnUsed[column]) {
+            columnUsed[column] = true;
+            columnMin[column] = columnMax[column] = p->y;
+            columnX[column] = p->x;
+        } else {
+            if (p->y < columnMin[column]) columnMin[column] = p->y;
+            if (p->y > columnMax[column]) columnMax[column] = p->y;
         }
     }
+
+    iSetColor(r, g, b);
+    glPushMatrix();
+    glTranslated(WINDOW_WIDTH / 2 + offsetX * scaleX, WINDOW_HEIGHT / 2 + offsetY * scaleY, 0);
+    glScaled(scaleX, scaleY, 1);
+    glBegin(GL_LINE_STRIP);
+    for (int column = 0; column < WINDOW_WIDTH; column++) {
+        if (!columnUsed[column]) continue;
+        glVertex2d(columnX[column], columnMin[column]);
+        glVertex2d(columnX[column], columnMax[column]);
+    }
+    glEnd();
+    glPopMatrix();
 }
 
 void plotFunctions() {
@@ -1210,6 +2089,8 @@ void plotFunctions() {
     if (showLog) plotFunction("logarithm", colorLog.r, colorLog.g, colorLog.b);
     if (showLn) plotFunction("natural_log", colorLn.r, colorLn.g, colorLn.b);
     if (showPoly) plotFunction("polynomial", colorPoly.r, colorPoly.g, colorPoly.b);
+    if (showData) plotDataSeries(&dataSeries, colorData.r, colorData.g, colorData.b);
+    if (showStream) plotStream(colorStream.r, colorStream.g, colorStream.b);
     
     if (showCircle) {
         iSetColor(colorCircle.r, colorCircle.g, colorCircle.b);
@@ -1287,6 +2168,872 @@ void plotFunctions() {
     }
 }
 
+// Vector export of the current view ('v'): plot.svg and plot.pdf. Every curve
+// becomes one path made of polyline runs, broken only where the curve is
+// undefined or jumps across a pole. Runs are sampled with the same adaptive
+// steps as the screen and then thinned with Ramer-Douglas-Peucker to
+// EXPORT_TOLERANCE pixels, so file size follows how much the curves bend
+// rather than how small `step` is.
+#define EXPORT_TOLERANCE 0.25      // pixels a simplified run may stray from its samples
+#define EXPORT_MAX_PATHS 40        // axes, each function with its derivative and tangent, conics
+#define EXPORT_MAX_LABELS 128
+#define EXPORT_SVG_FILE "plot.svg"
+#define EXPORT_PDF_FILE "plot.pdf"
+
+typedef struct {
+    double x, y;
+} PathPoint;
+
+typedef struct {
+    Color color;
+    double width;
+    PathPoint *points;          // simplified runs, one after another, in screen pixels
+    int count, capacity;
+    int *runEnd;                // one past the last point of each run
+    int runCount, runCapacity;
+} ExportPath;
+
+typedef struct {
+    double x, y;
+    char text[64];
+} ExportLabel;
+
+typedef struct {
+    char *data;
+    int length, capacity;
+} TextBuffer;
+
+// Buffers are kept between exports and only ever grow
+ExportPath exportPaths[EXPORT_MAX_PATHS];
+int exportPathCount = 0;
+ExportLabel exportLabels[EXPORT_MAX_LABELS];
+int exportLabelCount = 0;
+PathPoint *exportRun = NULL;    // samples of the run being traced
+int exportRunCount = 0, exportRunCapacity = 0;
+int *exportStack = NULL;        // RDP work list, two ints per pending span
+char *exportKeep = NULL;
+bool exportFailed = false;      // some buffer could not grow; the export is abandoned
+char exportStatus[100] = "";
+
+static bool growArray(void **data, int *capacity, int needed, size_t size) {
+    if (needed <= *capacity) return true;
+    int grown = *capacity > 0 ? *capacity : 256;
+    while (grown < needed) grown *= 2;
+    void *p = realloc(*data, grown * size);
+    if (p == NULL) return false;
+    *data = p;
+    *capacity = grown;
+    return true;
+}
+
+static ExportPath *beginExportPath(Color color, double width) {
+    if (exportPathCount == EXPORT_MAX_PATHS) {
+        exportFailed = true;
+        return NULL;
+    }
+    ExportPath *path = &exportPaths[exportPathCount++];
+    path->color = color;
+    path->width = width;
+    path->count = 0;
+    path->runCount = 0;
+    return path;
+}
+
+static void addRunPoint(double sx, double sy) {
+    if (exportFailed) return;
+    if (exportRunCount == exportRunCapacity) {
+        // The RDP work arrays are sized with the run
+        int capacity = exportRunCapacity > 0 ? exportRunCapacity * 2 : 1024;
+        PathPoint *run = (PathPoint *)realloc(exportRun, capacity * sizeof(PathPoint));
+        if (run != NULL) exportRun = run;
+        char *keep = (char *)realloc(exportKeep, capacity);
+        if (keep != NULL) exportKeep = keep;
+        int *stack = (int *)realloc(exportStack, 2 * capacity * sizeof(int));
+        if (stack != NULL) exportStack = stack;
+        if (run == NULL || keep == NULL || stack == NULL) {
+            exportFailed = true;
+            return;
+        }
+        exportRunCapacity = capacity;
+    }
+    exportRun[exportRunCount].x = sx;
+    exportRun[exportRunCount].y = sy;
+    exportRunCount++;
+}
+
+// Simplifies the traced run into path and starts a new one
+static void endRun(ExportPath *path) {
+    int n = exportRunCount;
+    exportRunCount = 0;
+    if (n < 2 || path == NULL || exportFailed) return;
+
+    // Ramer-Douglas-Peucker without recursion: split each span at the sample
+    // farthest from its chord until every sample is within tolerance
+    memset(exportKeep, 0, n);
+    exportKeep[0] = exportKeep[n - 1] = 1;
+    int top = 0;
+    exportStack[top++] = 0;
+    exportStack[top++] = n - 1;
+    while (top > 0) {
+        int last = exportStack[--top];
+        int first = exportStack[--top];
+        PathPoint a = exportRun[first];
+        double dx = exportRun[last].x - a.x, dy = exportRun[last].y - a.y;
+        double length = sqrt(dx * dx + dy * dy);
+
+        double worst = 0;
+        int split = -1;
+        for (int k = first + 1; k < last; k++) {
+            double ex = exportRun[k].x - a.x, ey = exportRun[k].y - a.y;
+            double d = length > 0 ? fabs(ex * dy - ey * dx) / length : sqrt(ex * ex + ey * ey);
+            if (d > worst) {
+                worst = d;
+                split = k;
+            }
+        }
+        if (worst > EXPORT_TOLERANCE) {
+            exportKeep[split] = 1;
+            exportStack[top++] = first;
+            exportStack[top++] = split;
+            exportStack[top++] = split;
+            exportStack[top++] = last;
+        }
+    }
+
+    int kept = 0;
+    for (int k = 0; k < n; k++) kept += exportKeep[k];
+    if (!growArray((void **)&path->points, &path->capacity, path->count + kept, sizeof(PathPoint)) ||
+        !growArray((void **)&path->runEnd, &path->runCapacity, path->runCount + 1, sizeof(int))) {
+        exportFailed = true;
+        return;
+    }
+    for (int k = 0; k < n; k++) {
+        if (exportKeep[k]) path->points[path->count++] = exportRun[k];
+    }
+    path->runEnd[path->runCount++] = path->count;
+}
+
+static void addExportLabel(double sx, double sy, const char *text) {
+    if (exportLabelCount == EXPORT_MAX_LABELS) return;
+    ExportLabel *label = &exportLabels[exportLabelCount++];
+    label->x = sx;
+    label->y = sy;
+    strncpy(label->text, text, sizeof(label->text) - 1);
+    label->text[sizeof(label->text) - 1] = '\0';
+}
+
+// Grid, axes, ticks and labels as drawGrid() lays them out
+static void exportAxes() {
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+    double startY = -offsetY - (WINDOW_HEIGHT / 2) / scaleY;
+    double endY = -offsetY + (WINDOW_HEIGHT / 2) / scaleY;
+    double axisX = WINDOW_WIDTH / 2 + offsetX * scaleX;
+    double axisY = WINDOW_HEIGHT / 2 + offsetY * scaleY;
+    Color gridColor = {GRID_COLOR_R, GRID_COLOR_G, GRID_COLOR_B};
+    Color axisColor = {MAIN_AXIS_COLOR_R, MAIN_AXIS_COLOR_G, MAIN_AXIS_COLOR_B};
+    char label[20];
+
+    if (showGridFlag) {
+        ExportPath *grid = beginExportPath(gridColor, 1);
+        for (double x = floor(startX / AXIS_LABEL_SPACING) * AXIS_LABEL_SPACING; x <= endX; x += AXIS_LABEL_SPACING) {
+            if (fabs(x) <= 1e-10) continue;
+            double screenX = WINDOW_WIDTH / 2 + (x + offsetX) * scaleX;
+            addRunPoint(screenX, 0);
+            addRunPoint(screenX, WINDOW_HEIGHT);
+            endRun(grid);
+        }
+        for (double y = floor(startY / AXIS_LABEL_SPACING) * AXIS_LABEL_SPACING; y <= endY; y += AXIS_LABEL_SPACING) {
+            if (fabs(y) <= 1e-10) continue;
+            double screenY = WINDOW_HEIGHT / 2 + (y + offsetY) * scaleY;
+            addRunPoint(0, screenY);
+            addRunPoint(WINDOW_WIDTH, screenY);
+            endRun(grid);
+        }
+    }
+
+    ExportPath *axes = beginExportPath(axisColor, MAIN_AXIS_THICKNESS);
+    addRunPoint(0, axisY);
+    addRunPoint(WINDOW_WIDTH, axisY);
+    endRun(axes);
+    addRunPoint(axisX, 0);
+    addRunPoint(axisX, WINDOW_HEIGHT);
+    endRun(axes);
+
+    ExportPath *ticks = beginExportPath(axisColor, 1);
+    for (double x = floor(startX / AXIS_LABEL_SPACING) * AXIS_LABEL_SPACING; x <= endX; x += AXIS_LABEL_SPACING) {
+        if (fabs(x) <= 1e-10) continue;
+        double screenX = WINDOW_WIDTH / 2 + (x + offsetX) * scaleX;
+        addRunPoint(screenX, axisY - TICK_SIZE / 2);
+        addRunPoint(screenX, axisY + TICK_SIZE / 2);
+        endRun(ticks);
+        sprintf(label, "%.0f", x);
+        addExportLabel(screenX - strlen(label) * 3, axisY - LABEL_OFFSET, label);
+    }
+    for (double y = floor(startY / AXIS_LABEL_SPACING) * AXIS_LABEL_SPACING; y <= endY; y += AXIS_LABEL_SPACING) {
+        if (fabs(y) <= 1e-10) continue;
+        double screenY = WINDOW_HEIGHT / 2 + (y + offsetY) * scaleY;
+        addRunPoint(axisX - TICK_SIZE / 2, screenY);
+        addRunPoint(axisX + TICK_SIZE / 2, screenY);
+        endRun(ticks);
+        sprintf(label, "%.0f", y);
+        addExportLabel(axisX + LABEL_OFFSET, screenY - 5, label);
+    }
+    addExportLabel(axisX + LABEL_OFFSET, axisY - LABEL_OFFSET, "0");
+}
+
+// Closed ellipse through n points of its parametric form, in screen pixels
+static void addEllipseRun(ExportPath *path, double cx, double cy, double rx, double ry) {
+    int n = (int)ceil(2 * 3.14159265 * (rx > ry ? rx : ry));   // a sample per pixel of the longer axis
+    if (n < 16) n = 16;
+    if (n > 100000) n = 100000;
+    for (int i = 0; i <= n; i++) {
+        double theta = 2 * 3.14159265 * i / n;
+        addRunPoint(cx + rx * cos(theta), cy + ry * sin(theta));
+    }
+    endRun(path);
+}
+
+// f' in the dimmed color, a sample per pixel, with the breaks plotDerivative() makes
+static void exportDerivative(const CompiledFunction *cf, Color color,
+                             double startX, double endX, double originX, double originY) {
+    Color dim = {color.r / 2, color.g / 2, color.b / 2};
+    ExportPath *path = beginExportPath(dim, 1);
+    double h = 1 / scaleX;
+    Jet j1 = evaluateCompiledJet(cf, startX);
+    for (double x = startX; x <= endX; x += h) {
+        Jet j2 = evaluateCompiledJet(cf, x + h);
+        double y1 = originY + j1.d1 * scaleY, y2 = originY + j2.d1 * scaleY;
+        bool drawn = isfinite(j1.d1) && isfinite(j2.d1) && fabs(j1.d1) <= 1e5 && fabs(j2.d1) <= 1e5 &&
+                     !((y1 < 0 || y1 > WINDOW_HEIGHT) && (y2 < 0 || y2 > WINDOW_HEIGHT));
+        j1 = j2;
+        if (drawn) {
+            if (exportRunCount == 0) addRunPoint(originX + x * scaleX, y1);
+            addRunPoint(originX + (x + h) * scaleX, y2);
+        } else {
+            endRun(path);
+        }
+    }
+    endRun(path);
+}
+
+// The tangent at the probe as a two-point run, with the probe and root markers
+// and labels plotTangent() draws
+static void exportTangent(const CompiledFunction *cf, Color color,
+                          double startX, double endX, double originX, double originY) {
+    Jet t = evaluateCompiledJet(cf, tangentX);
+    if (!isfinite(t.v) || !isfinite(t.d1) || fabs(t.v) > 1e5) return;
+
+    ExportPath *path = beginExportPath(color, 1);
+    addRunPoint(originX + startX * scaleX, originY + (t.v + t.d1 * (startX - tangentX)) * scaleY);
+    addRunPoint(originX + endX * scaleX, originY + (t.v + t.d1 * (endX - tangentX)) * scaleY);
+    endRun(path);
+
+    double px = originX + tangentX * scaleX;
+    double py = originY + t.v * scaleY;
+    addEllipseRun(path, px, py, 3, 3);
+
+    char label[80];
+    snprintf(label, sizeof(label), "y=%.3f y'=%.3f y''=%.3f", t.v, t.d1, t.d2);
+    addExportLabel(px + 6, py + 6, label);
+
+    double root;
+    if (refineRoot(cf, tangentX, &root) && root >= startX && root <= endX) {
+        addEllipseRun(path, originX + root * scaleX, originY, 4, 4);
+        snprintf(label, sizeof(label), "root %.6f", root);
+        addExportLabel(originX + root * scaleX + 6, originY - 16, label);
+    }
+}
+
+// Traces func over the view with the steps sampleRetainedCurve() takes
+static void exportFunction(const char *func, Color color) {
+    ExportPath *path = beginExportPath(color, 1);
+    CompiledFunction cf;
+    compileFunction(func, &cf);
+
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+    double height = WINDOW_HEIGHT / scaleY;
+    double y0 = -offsetY - height * 1.5;    // a window above and below stays in the runs
+    double y1 = -offsetY + height * 1.5;
+    double originX = WINDOW_WIDTH / 2 + offsetX * scaleX;
+    double originY = WINDOW_HEIGHT / 2 + offsetY * scaleY;
+    double maxStep = MAX_SEGMENT_PIXELS / scaleX;
+    if (maxStep < step) maxStep = step;
+
+    double x = startX;
+    Jet j1 = evaluateCompiledJet(&cf, x);
+    while (x < endX) {
+        double h = curvatureStep(j1, step, maxStep);
+        Jet j2 = evaluateCompiledJet(&cf, x + h);
+        bool drawn = isfinite(j1.v) && isfinite(j2.v) && fabs(j1.v) <= 1e5 && fabs(j2.v) <= 1e5 &&
+                     !((j1.v < y0 || j1.v > y1) && (j2.v < y0 || j2.v > y1)) && !crossesPole(j1, j2);
+        if (drawn) {
+            if (exportRunCount == 0) addRunPoint(originX + x * scaleX, originY + j1.v * scaleY);
+            addRunPoint(originX + (x + h) * scaleX, originY + j2.v * scaleY);
+        } else {
+            endRun(path);
+        }
+        x += h;
+        j1 = j2;
+    }
+    endRun(path);
+
+    if (showDerivatives) exportDerivative(&cf, color, startX, endX, originX, originY);
+    if (showTangent) exportTangent(&cf, color, startX, endX, originX, originY);
+}
+
+static void exportConic(Color color, double cx, double cy, double rx, double ry) {
+    addEllipseRun(beginExportPath(color, 1), cx, cy, rx, ry);
+}
+
+// y = a x^2 + b x + c, half a pixel apart before simplification
+static void exportParabola(Color color) {
+    ExportPath *path = beginExportPath(color, 1);
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+    double h = 0.5 / scaleX;
+    for (double x = startX; x <= endX + h; x += h) {
+        double y = customParabola.a * x * x + customParabola.b * x + customParabola.c;
+        if (!isfinite(y) || fabs(y) > 1e5) {
+            endRun(path);
+            continue;
+        }
+        addRunPoint(WINDOW_WIDTH / 2 + (x + offsetX) * scaleX, WINDOW_HEIGHT / 2 + (y + offsetY) * scaleY);
+    }
+    endRun(path);
+}
+
+// Both branches of y = k +- b sqrt((x - h)^2 / a^2 - 1), as plotFunctions() draws them
+static void exportHyperbola(Color color) {
+    ExportPath *path = beginExportPath(color, 1);
+    float h = customHyperbola.h, k = customHyperbola.k, a = customHyperbola.a, b = customHyperbola.b;
+    double startX = -offsetX - (WINDOW_WIDTH / 2) / scaleX;
+    double endX = -offsetX + (WINDOW_WIDTH / 2) / scaleX;
+    double dx = 0.5 / scaleX;
+    for (int sign = 1; sign >= -1; sign -= 2) {
+        for (double x = startX; x <= endX + dx; x += dx) {
+            double y = k + sign * b * sqrt((x - h) * (x - h) / (a * a) - 1);
+            if (!isfinite(y)) {
+                endRun(path);
+                continue;
+            }
+            addRunPoint(WINDOW_WIDTH / 2 + (x + offsetX) * scaleX, WINDOW_HEIGHT / 2 + (y + offsetY) * scaleY);
+        }
+        endRun(path);
+    }
+}
+
+static void appendText(TextBuffer *buffer, const char *format, ...) {
+    // Every piece appended is a short line, well under the 256 bytes reserved
+    if (exportFailed) return;
+    if (!growArray((void **)&buffer->data, &buffer->capacity, buffer->length + 256, 1)) {
+        exportFailed = true;
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer->data + buffer->length, 256, format, args);
+    va_end(args);
+    if (written > 0 && written < 256) buffer->length += written;
+}
+
+static void appendSvg(TextBuffer *svg) {
+    appendText(svg, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    appendText(svg, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n",
+               WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_WIDTH, WINDOW_HEIGHT);
+    appendText(svg, "<rect width=\"%d\" height=\"%d\" fill=\"black\"/>\n", WINDOW_WIDTH, WINDOW_HEIGHT);
+    for (int i = 0; i < exportPathCount; i++) {
+        const ExportPath *path = &exportPaths[i];
+        if (path->runCount == 0) continue;
+        appendText(svg, "<path fill=\"none\" stroke=\"rgb(%d,%d,%d)\" stroke-width=\"%g\" stroke-linejoin=\"round\" d=\"",
+                   (int)path->color.r, (int)path->color.g, (int)path->color.b, path->width);
+        int k = 0;
+        for (int run = 0; run < path->runCount; run++) {
+            // The points after M are implicit L commands
+            appendText(svg, "%sM%.2f %.2f", run > 0 ? "\n" : "", path->points[k].x, WINDOW_HEIGHT - path->points[k].y);
+            for (k++; k < path->runEnd[run]; k++) {
+                appendText(svg, " %.2f %.2f", path->points[k].x, WINDOW_HEIGHT - path->points[k].y);
+            }
+        }
+        appendText(svg, "\"/>\n");
+    }
+    appendText(svg, "<g fill=\"white\" font-family=\"Helvetica\" font-size=\"10\">\n");
+    for (int i = 0; i < exportLabelCount; i++) {
+        appendText(svg, "<text x=\"%.1f\" y=\"%.1f\">%s</text>\n",
+                   exportLabels[i].x, WINDOW_HEIGHT - exportLabels[i].y, exportLabels[i].text);
+    }
+    appendText(svg, "</g>\n</svg>\n");
+}
+
+// Page content in PDF user space, which is y-up like the window
+static void appendPdfContent(TextBuffer *content) {
+    appendText(content, "0 0 0 rg 0 0 %d %d re f\n", WINDOW_WIDTH, WINDOW_HEIGHT);
+    appendText(content, "0 0 %d %d re W n\n1 J 1 j\n", WINDOW_WIDTH, WINDOW_HEIGHT);
+    for (int i = 0; i < exportPathCount; i++) {
+        const ExportPath *path = &exportPaths[i];
+        if (path->runCount == 0) continue;
+        appendText(content, "%.3f %.3f %.3f RG %g w\n",
+                   path->color.r / 255, path->color.g / 255, path->color.b / 255, path->width);
+        int k = 0;
+        for (int run = 0; run < path->runCount; run++) {
+            appendText(content, "%.2f %.2f m\n", path->points[k].x, path->points[k].y);
+            for (k++; k < path->runEnd[run]; k++) {
+                appendText(content, "%.2f %.2f l\n", path->points[k].x, path->points[k].y);
+            }
+        }
+        appendText(content, "S\n");
+    }
+    appendText(content, "1 1 1 rg\n");
+    for (int i = 0; i < exportLabelCount; i++) {
+        // Labels are plain numbers, so nothing needs escaping inside ( )
+        appendText(content, "BT /F1 10 Tf %.1f %.1f Td (%s) Tj ET\n",
+                   exportLabels[i].x, exportLabels[i].y, exportLabels[i].text);
+    }
+}
+
+static bool writeTextFile(const char *path, const TextBuffer *buffer) {
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) return false;
+    bool ok = fwrite(buffer->data, 1, buffer->length, out) == (size_t)buffer->length;
+    return fclose(out) == 0 && ok;
+}
+
+// One page holding content, with Helvetica for the labels. Binary mode keeps
+// the byte offsets in the cross-reference table exact.
+static bool writePdf(const char *path, const TextBuffer *content) {
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) return false;
+    long offsets[6];
+
+    fprintf(out, "%%PDF-1.4\n");
+    offsets[1] = ftell(out);
+    fprintf(out, "1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n");
+    offsets[2] = ftell(out);
+    fprintf(out, "2 0 obj\n<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n");
+    offsets[3] = ftell(out);
+    fprintf(out, "3 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 %d %d] "
+                 "/Resources << /Font << /F1 5 0 R >> >> /Contents 4 0 R >>\nendobj\n", WINDOW_WIDTH, WINDOW_HEIGHT);
+    offsets[4] = ftell(out);
+    fprintf(out, "4 0 obj\n<< /Length %d >>\nstream\n", content->length);
+    fwrite(content->data, 1, content->length, out);
+    fprintf(out, "endstream\nendobj\n");
+    offsets[5] = ftell(out);
+    fprintf(out, "5 0 obj\n<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>\nendobj\n");
+
+    long xref = ftell(out);
+    fprintf(out, "xref\n0 6\n0000000000 65535 f \n");
+    for (int i = 1; i <= 5; i++) fprintf(out, "%010ld 00000 n \n", offsets[i]);
+    fprintf(out, "trailer\n<< /Size 6 /Root 1 0 R >>\nstartxref\n%ld\n%%%%EOF\n", xref);
+    return fclose(out) == 0;
+}
+
+void exportView() {
+    exportPathCount = 0;
+    exportLabelCount = 0;
+    exportRunCount = 0;
+    exportFailed = false;
+
+    exportAxes();
+    if (showSin) exportFunction("custom_sin", colorSin);
+    if (showCos) exportFunction("custom_cos", colorCos);
+    if (showTan) exportFunction("custom_tan", colorTan);
+    if (showASin) exportFunction("custom_asin", colorASin);
+    if (showACos) exportFunction("custom_acos", colorACos);
+    if (showATan) exportFunction("custom_atan", colorATan);
+    if (showExp) exportFunction("exponential", colorExp);
+    if (showLog) exportFunction("logarithm", colorLog);
+    if (showLn) exportFunction("natural_log", colorLn);
+    if (showPoly) exportFunction("polynomial", colorPoly);
+    if (showCircle) {
+        exportConic(colorCircle, WINDOW_WIDTH / 2 + (customCircle.h + offsetX) * scaleX,
+                    WINDOW_HEIGHT / 2 + (customCircle.k + offsetY) * scaleY, customCircle.r * scaleX, customCircle.r * scaleX);
+    }
+    if (showEllipse) {
+        exportConic(colorEllipse, WINDOW_WIDTH / 2 + (customEllipse.h + offsetX) * scaleX,
+                    WINDOW_HEIGHT / 2 + (customEllipse.k + offsetY) * scaleY, customEllipse.a * scaleX, customEllipse.b * scaleY);
+    }
+    if (showParabola) exportParabola(colorParabola);
+    if (showHyperbola) exportHyperbola(colorHyperbola);
+
+    TextBuffer svg = {NULL, 0, 0};
+    TextBuffer pdf = {NULL, 0, 0};
+    appendSvg(&svg);
+    appendPdfContent(&pdf);
+
+    int points = 0;
+    for (int i = 0; i < exportPathCount; i++) points += exportPaths[i].count;
+    if (exportFailed) {
+        strcpy(exportStatus, "Export failed: not enough memory");
+    } else if (!writeTextFile(EXPORT_SVG_FILE, &svg) || !writePdf(EXPORT_PDF_FILE, &pdf)) {
+        strcpy(exportStatus, "Export failed: cannot write " EXPORT_SVG_FILE " / " EXPORT_PDF_FILE);
+    } else {
+        sprintf(exportStatus, "Exported %s and %s (%d points)", EXPORT_SVG_FILE, EXPORT_PDF_FILE, points);
+    }
+    free(svg.data);
+    free(pdf.data);
+}
+
+// Samples of one active function written to a file ('w'): "sin -10 10 1000000
+// csv" gives sin.csv with one "x,y" line per sample, "bin" gives sin.f64 with
+// raw little-endian float64 x, y pairs. y comes from evaluateCompiledBatch(),
+// the evaluator behind the plot, and is printed with 17 significant digits so
+// it reads back bit for bit. Worker threads each evaluate and format one slice
+// of consecutive samples; the slices of a round are then written in order.
+#define SAMPLE_SLICE 65536          // samples a worker formats per round
+#define SAMPLE_BLOCK 1024           // samples evaluated per batch call
+#define MAX_SAMPLE_THREADS 16
+#define SAMPLE_LINE_LENGTH 52       // longest "x,y\n" line %.17g can produce
+
+typedef struct {
+    const char *name;       // as typed
+    const char *function;   // as compileFunction() knows it
+    bool *shown;
+} SampleTarget;
+
+SampleTarget sampleTargets[] = {
+    {"sin", "custom_sin", &showSin}, {"cos", "custom_cos", &showCos}, {"tan", "custom_tan", &showTan},
+    {"asin", "custom_asin", &showASin}, {"acos", "custom_acos", &showACos}, {"atan", "custom_atan", &showATan},
+    {"exp", "exponential", &showExp}, {"log", "logarithm", &showLog}, {"ln", "natural_log", &showLn},
+    {"poly", "polynomial", &showPoly},
+};
+
+typedef struct {
+    const CompiledFunction *cf;
+    double x0, dx;
+    long long first;        // index of the slice's first sample
+    int count;
+    bool binary;
+    char *buffer;           // SAMPLE_SLICE samples' worth, kept for the whole export
+    int length;
+} SampleSlice;
+
+DWORD WINAPI sampleSliceWorker(LPVOID arg) {
+    SampleSlice *slice = (SampleSlice *)arg;
+    double x[SAMPLE_BLOCK], y[SAMPLE_BLOCK];
+    char *out = slice->buffer;
+
+    for (int k0 = 0; k0 < slice->count; k0 += SAMPLE_BLOCK) {
+        int n = slice->count - k0 < SAMPLE_BLOCK ? slice->count - k0 : SAMPLE_BLOCK;
+        for (int k = 0; k < n; k++) x[k] = slice->x0 + (slice->first + k0 + k) * slice->dx;
+        evaluateCompiledBatch(slice->cf, x, y, n);
+
+        if (slice->binary) {
+            for (int k = 0; k < n; k++) {
+                memcpy(out, &x[k], sizeof(double));
+                memcpy(out + sizeof(double), &y[k], sizeof(double));
+                out += 2 * sizeof(double);
+            }
+        } else {
+            // An undefined y is left empty rather than printed as the C library spells infinity
+            for (int k = 0; k < n; k++) {
+                out += isfinite(y[k]) ? sprintf(out, "%.17g,%.17g\n", x[k], y[k]) : sprintf(out, "%.17g,\n", x[k]);
+            }
+        }
+    }
+    slice->length = out - slice->buffer;
+    return 0;
+}
+
+// Parses "name x0 x1 count csv|bin" and writes the file; the outcome goes to exportStatus
+int exportSamples(const char *request) {
+    char name[MAX_INPUT_LENGTH], format[MAX_INPUT_LENGTH];
+    double x0, x1, countValue;
+    strcpy(format, "csv");
+    // The count is read as a double: the C library of older MinGW has no %lld
+    if (sscanf(request, "%99s %lf %lf %lf %99s", name, &x0, &x1, &countValue, format) < 4 ||
+        !(countValue >= 2 && countValue <= 1e15) || !isfinite(x0) || !isfinite(x1) || x1 <= x0) {
+        strcpy(exportStatus, "Expected: name x0 x1 count [csv|bin], x0 < x1, count >= 2");
+        return 0;
+    }
+    long long count = (long long)countValue;
+    bool binary = strcmp(format, "bin") == 0;
+    if (!binary && strcmp(format, "csv") != 0) {
+        strcpy(exportStatus, "Format must be csv or bin");
+        return 0;
+    }
+
+    const SampleTarget *target = NULL;
+    for (int i = 0; i < (int)(sizeof(sampleTargets) / sizeof(sampleTargets[0])); i++) {
+        if (strcmp(sampleTargets[i].name, name) == 0) target = &sampleTargets[i];
+    }
+    if (target == NULL || !*target->shown) {
+        strcpy(exportStatus, "Not an active function: sin cos tan asin acos atan exp log ln poly");
+        return 0;
+    }
+
+    char path[MAX_INPUT_LENGTH + 8];
+    sprintf(path, "%s.%s", name, binary ? "f64" : "csv");
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        sprintf(exportStatus, "Cannot write %s", path);
+        return 0;
+    }
+    setvbuf(out, NULL, _IOFBF, 1 << 20);
+
+    SYSTEM_INFO system;
+    GetSystemInfo(&system);
+    int threads = system.dwNumberOfProcessors;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_SAMPLE_THREADS) threads = MAX_SAMPLE_THREADS;
+
+    CompiledFunction cf;
+    compileFunction(target->function, &cf);
+    int bytesPerSample = binary ? 2 * sizeof(double) : SAMPLE_LINE_LENGTH;
+    SampleSlice slices[MAX_SAMPLE_THREADS];
+    HANDLE workers[MAX_SAMPLE_THREADS];
+    bool ok = true;
+    for (int t = 0; t < threads; t++) {
+        slices[t].cf = &cf;
+        slices[t].x0 = x0;
+        slices[t].dx = (x1 - x0) / (count - 1);
+        slices[t].binary = binary;
+        slices[t].buffer = (char *)malloc((size_t)SAMPLE_SLICE * bytesPerSample);
+        if (slices[t].buffer == NULL) ok = false;
+    }
+
+    DWORD started = GetTickCount();
+    for (long long first = 0; ok && first < count; first += (long long)threads * SAMPLE_SLICE) {
+        int running = 0;
+        for (int t = 0; t < threads && first + (long long)t * SAMPLE_SLICE < count; t++) {
+            SampleSlice *slice = &slices[t];
+            slice->first = first + (long long)t * SAMPLE_SLICE;
+            slice->count = count - slice->first < SAMPLE_SLICE ? (int)(count - slice->first) : SAMPLE_SLICE;
+            // The last slice is formatted here rather than waiting idle
+            workers[running] = t + 1 < threads ? CreateThread(NULL, 0, sampleSliceWorker, slice, 0, NULL) : NULL;
+            if (workers[running] == NULL) {
+                sampleSliceWorker(slice);
+            } else {
+                running++;
+            }
+        }
+        if (running > 0) WaitForMultipleObjects(running, workers, TRUE, INFINITE);
+        for (int t = 0; t < running; t++) CloseHandle(workers[t]);
+
+        for (int t = 0; ok && t < threads && first + (long long)t * SAMPLE_SLICE < count; t++) {
+            ok = fwrite(slices[t].buffer, 1, slices[t].length, out) == (size_t)slices[t].length;
+        }
+    }
+    ok = fclose(out) == 0 && ok;
+    DWORD elapsed = GetTickCount() - started;
+    for (int t = 0; t < threads; t++) free(slices[t].buffer);
+
+    if (!ok) {
+        sprintf(exportStatus, "Writing %s failed", path);
+        return 0;
+    }
+    sprintf(exportStatus, "Wrote %.0f samples to %s in %lu ms on %d threads", (double)count, path, (unsigned long)elapsed, threads);
+    return 1;
+}
+
+// Headless batch rendering: "iMain --render jobs.txt" draws every job in the
+// file to a PPM image without opening a window. Each job line reads
+//   kind output.ppm width height x0 x1 y0 y1 r g b equation
+// with kind one of sin cos tan asin acos atan exp log ln poly, and the
+// equation written as it would be typed for that key ('#' starts a comment).
+// Jobs are compiled one after another on the main thread, because the
+// equation readers fill the shared custom* structs; the compiled functions
+// are then drawn by a pool of worker threads into private pixel buffers.
+#define RENDER_SUBSAMPLES 4         // samples per pixel column
+#define RENDER_MAX_SIZE 16384
+#define MAX_RENDER_THREADS 16
+
+typedef struct {
+    char output[MAX_INPUT_LENGTH];
+    int width, height;
+    double x0, x1, y0, y1;
+    Color color;
+    CompiledFunction cf;
+    bool ok;
+} RenderJob;
+
+RenderJob *renderJobs = NULL;
+int renderJobCount = 0;
+volatile LONG nextRenderJob = 0;
+
+// Parses equation with the reader the kind's key uses
+static int readJobFunction(const char *kind, const char *equation) {
+    char funcType[20] = "";
+    if (strcmp(kind, "sin") == 0) return readTrigFunction(equation, &customSin.A, &customSin.B, &customSin.C, &customSin.D, "sin");
+    if (strcmp(kind, "cos") == 0) return readTrigFunction(equation, &customCos.A, &customCos.B, &customCos.C, &customCos.D, "cos");
+    if (strcmp(kind, "tan") == 0) return readTrigFunction(equation, &customTan.A, &customTan.B, &customTan.C, &customTan.D, "tan");
+    if (strcmp(kind, "asin") == 0) return readInverseTrigFunction(equation, &customASin.A, &customASin.B, &customASin.C, &customASin.D, funcType);
+    if (strcmp(kind, "acos") == 0) return readInverseTrigFunction(equation, &customACos.A, &customACos.B, &customACos.C, &customACos.D, funcType);
+    if (strcmp(kind, "atan") == 0) return readInverseTrigFunction(equation, &customATan.A, &customATan.B, &customATan.C, &customATan.D, funcType);
+    if (strcmp(kind, "exp") == 0) return readExponentialFunction(equation, &customExp.A, &customExp.B, &customExp.C, &customExp.D);
+    if (strcmp(kind, "log") == 0) return readLogFunction(equation, &customLog.A, &customLog.B, &customLog.C, &customLog.D, "log");
+    if (strcmp(kind, "ln") == 0) return readLogFunction(equation, &customLn.A, &customLn.B, &customLn.C, &customLn.D, "ln");
+    if (strcmp(kind, "poly") == 0) return readPolynomial(equation, &customPoly.a4, &customPoly.a3, &customPoly.a2, &customPoly.a1, &customPoly.a0);
+    return 0;
+}
+
+static bool readRenderJobs(const char *path) {
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        printf("Cannot open %s\n", path);
+        return false;
+    }
+    char line[512];
+    int lineNumber = 0, capacity = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), in) != NULL) {
+        lineNumber++;
+        line[strcspn(line, "\r\n")] = '\0';
+        const char *start = line + strspn(line, " \t");
+        if (*start == '\0' || *start == '#') continue;
+
+        RenderJob job;
+        memset(&job, 0, sizeof(job));
+        char kind[20];
+        int used = 0;
+        const SampleTarget *target = NULL;
+        if (sscanf(start, "%19s %99s %d %d %lf %lf %lf %lf %lf %lf %lf %n", kind, job.output, &job.width, &job.height,
+                   &job.x0, &job.x1, &job.y0, &job.y1, &job.color.r, &job.color.g, &job.color.b, &used) == 11 &&
+            job.width > 0 && job.width <= RENDER_MAX_SIZE && job.height > 0 && job.height <= RENDER_MAX_SIZE &&
+            job.x1 > job.x0 && job.y1 > job.y0 && readJobFunction(kind, start + used)) {
+            for (int i = 0; i < (int)(sizeof(sampleTargets) / sizeof(sampleTargets[0])); i++) {
+                if (strcmp(sampleTargets[i].name, kind) == 0) target = &sampleTargets[i];
+            }
+        }
+        if (target == NULL) {
+            printf("%s:%d: expected kind output width height x0 x1 y0 y1 r g b equation\n", path, lineNumber);
+            continue;
+        }
+        compileFunction(target->function, &job.cf);
+
+        if (renderJobCount == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 64;
+            RenderJob *jobs = (RenderJob *)realloc(renderJobs, capacity * sizeof(RenderJob));
+            if (jobs == NULL) {
+                printf("Not enough memory for %d jobs\n", capacity);
+                ok = false;
+                break;
+            }
+            renderJobs = jobs;
+        }
+        renderJobs[renderJobCount++] = job;
+    }
+    fclose(in);
+    return ok;
+}
+
+static void putRenderPixel(unsigned char *pixels, const RenderJob *job, int x, int y, const Color *c) {
+    if (x < 0 || x >= job->width || y < 0 || y >= job->height) return;
+    unsigned char *p = pixels + 3 * ((size_t)(job->height - 1 - y) * job->width + x);   // PPM rows run top down
+    p[0] = (unsigned char)c->r;
+    p[1] = (unsigned char)c->g;
+    p[2] = (unsigned char)c->b;
+}
+
+// Segment in pixel coordinates, clipped to the image height first so a
+// near-vertical segment costs no more than the image is tall
+static void renderSegment(unsigned char *pixels, const RenderJob *job, double xa, double ya, double xb, double yb) {
+    if ((ya < 0 && yb < 0) || (ya >= job->height && yb >= job->height)) return;
+    if (ya < -1) ya = -1;
+    if (yb < -1) yb = -1;
+    if (ya > job->height) ya = job->height;
+    if (yb > job->height) yb = job->height;
+
+    int steps = (int)ceil(fabs(xb - xa) > fabs(yb - ya) ? fabs(xb - xa) : fabs(yb - ya));
+    if (steps < 1) steps = 1;
+    for (int s = 0; s <= steps; s++) {
+        double t = (double)s / steps;
+        putRenderPixel(pixels, job, (int)floor(xa + (xb - xa) * t), (int)floor(ya + (yb - ya) * t), &job->color);
+    }
+}
+
+static bool renderJob(RenderJob *job, unsigned char *pixels) {
+    int width = job->width, height = job->height;
+    double pixelsPerX = width / (job->x1 - job->x0);
+    double pixelsPerY = height / (job->y1 - job->y0);
+    memset(pixels, 0, (size_t)width * height * 3);
+
+    // Axes where they fall inside the image
+    Color axisColor = {MAIN_AXIS_COLOR_R, MAIN_AXIS_COLOR_G, MAIN_AXIS_COLOR_B};
+    int axisX = (int)floor(-job->x0 * pixelsPerX);
+    int axisY = (int)floor(-job->y0 * pixelsPerY);
+    for (int x = 0; axisY >= 0 && axisY < height && x < width; x++) putRenderPixel(pixels, job, x, axisY, &axisColor);
+    for (int y = 0; axisX >= 0 && axisX < width && y < height; y++) putRenderPixel(pixels, job, axisX, y, &axisColor);
+
+    // Segments between subsamples, skipping gaps and jumps across poles as the screen does
+    int samples = width * RENDER_SUBSAMPLES;
+    double dx = (job->x1 - job->x0) / samples;
+    Jet j1 = evaluateCompiledJet(&job->cf, job->x0);
+    for (int k = 0; k < samples; k++) {
+        Jet j2 = evaluateCompiledJet(&job->cf, job->x0 + (k + 1) * dx);
+        double rise = j2.v - j1.v;
+        bool pole = fabs(rise) * pixelsPerY > height && (rise * j1.d1 < 0 || rise * j2.d1 < 0);
+        if (isfinite(j1.v) && isfinite(j2.v) && !pole) {
+            renderSegment(pixels, job, (double)k / RENDER_SUBSAMPLES, (j1.v - job->y0) * pixelsPerY,
+                          (double)(k + 1) / RENDER_SUBSAMPLES, (j2.v - job->y0) * pixelsPerY);
+        }
+        j1 = j2;
+    }
+
+    FILE *out = fopen(job->output, "wb");
+    if (out == NULL) return false;
+    fprintf(out, "P6\n%d %d\n255\n", width, height);
+    bool ok = fwrite(pixels, 3, (size_t)width * height, out) == (size_t)width * height;
+    return fclose(out) == 0 && ok;
+}
+
+// Pool worker: takes the next unclaimed job until none are left, reusing one pixel buffer
+DWORD WINAPI renderWorker(LPVOID) {
+    unsigned char *pixels = NULL;
+    size_t capacity = 0;
+    for (;;) {
+        LONG index = InterlockedIncrement(&nextRenderJob) - 1;
+        if (index >= renderJobCount) break;
+        RenderJob *job = &renderJobs[index];
+        size_t size = (size_t)job->width * job->height * 3;
+        if (size > capacity) {
+            free(pixels);
+            pixels = (unsigned char *)malloc(size);
+            capacity = pixels != NULL ? size : 0;
+        }
+        job->ok = pixels != NULL && renderJob(job, pixels);
+    }
+    free(pixels);
+    return 0;
+}
+
+int renderJobFile(const char *path) {
+    if (!readRenderJobs(path)) return 1;
+
+    SYSTEM_INFO system;
+    GetSystemInfo(&system);
+    int threads = system.dwNumberOfProcessors;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_RENDER_THREADS) threads = MAX_RENDER_THREADS;
+    if (threads > renderJobCount) threads = renderJobCount > 0 ? renderJobCount : 1;
+
+    DWORD started = GetTickCount();
+    HANDLE workers[MAX_RENDER_THREADS];
+    int running = 0;
+    for (int t = 1; t < threads; t++) {
+        workers[running] = CreateThread(NULL, 0, renderWorker, NULL, 0, NULL);
+        if (workers[running] != NULL) running++;
+    }
+    renderWorker(NULL);     // the main thread is the last worker
+    if (running > 0) WaitForMultipleObjects(running, workers, TRUE, INFINITE);
+    for (int t = 0; t < running; t++) CloseHandle(workers[t]);
+    double seconds = (GetTickCount() - started) / 1000.0;
+
+    int failed = 0;
+    for (int i = 0; i < renderJobCount; i++) {
+        if (!renderJobs[i].ok) {
+            printf("Could not write %s\n", renderJobs[i].output);
+            failed++;
+        }
+    }
+    int cores = running + 1;
+    double rate = seconds > 0 ? renderJobCount / seconds : 0;
+    printf("Rendered %d of %d images in %.3f s on %d threads: %.1f images/s, %.1f images/s per core\n",
+           renderJobCount - failed, renderJobCount, seconds, cores, rate, rate / cores);
+    free(renderJobs);
+    return failed > 0 ? 1 : 0;
+}
+
 void drawUI() {
     // Only show basic instructions when no special mode is active
     if (!isSettingColor && !isEnteringEquation && !showPresetMenu) {
@@ -1297,6 +3044,7 @@ void drawUI() {
         char zoomText[50];
         sprintf(zoomText, "Zoom: %.2f", scaleX);
         iText(10, WINDOW_HEIGHT - 60, zoomText);
+        if (exportStatus[0] != '\0') iText(10, WINDOW_HEIGHT - 80, exportStatus);
 
         // Show active functions and their coefficients
         int yPos = WINDOW_HEIGHT - 100;
@@ -1419,7 +3167,12 @@ void drawUI() {
         iText(60, WINDOW_HEIGHT-200, "0: Logarithm | -: Natural Log | =: Inverse Trig");
         iText(60, WINDOW_HEIGHT-240, "Controls:");
         iText(60, WINDOW_HEIGHT-260, "[,]: Zoom | Arrows/Mouse: Pan | g: Toggle grid");
-        iText(60, WINDOW_HEIGHT-300, "Press 'h' to close help");
+        iText(60, WINDOW_HEIGHT-280, "d: Derivatives | Right click: Tangent | t: Hide tangent");
+        iText(60, WINDOW_HEIGHT-300, "o: Open data file (CSV or .pts)");
+        iText(60, WINDOW_HEIGHT-320, "i: Stream from stdin or a pipe | f: Follow stream");
+        iText(60, WINDOW_HEIGHT-340, "v: Export view to plot.svg and plot.pdf");
+        iText(60, WINDOW_HEIGHT-360, "w: Write samples of a function to CSV or float64");
+        iText(60, WINDOW_HEIGHT-380, "Press 'h' to close help");
     }
 
     // Show color setting UI only when active
@@ -1521,6 +3274,18 @@ void drawUI() {
             strcpy(format, "Format: y = [A]atan([B]x + [C]) + [D]");
             strcpy(example, "Example: y = atan(x) or y = 2atan(2x) - 1");
         }
+        else if (strcmp(currentFunction, "data") == 0) {
+            strcpy(format, dataError[0] != '\0' ? dataError : "File: x,y rows sorted by x");
+            strcpy(example, "Example: samples.csv or samples.csv.pts");
+        }
+        else if (strcmp(currentFunction, "stream") == 0) {
+            strcpy(format, dataError[0] != '\0' ? dataError : "Source: - for stdin, or a pipe name");
+            strcpy(example, "Example: - or sensor (\\\\.\\pipe\\sensor)");
+        }
+        else if (strcmp(currentFunction, "samples") == 0) {
+            strcpy(format, exportStatus[0] != '\0' ? exportStatus : "Samples: name x0 x1 count [csv|bin]");
+            strcpy(example, "Example: sin -10 10 1000000 csv");
+        }
         // Display input box with white background
         iSetColor(255, 255, 255);
         iFilledRectangle(207, WINDOW_HEIGHT - 95, WINDOW_WIDTH/3 + 120, 40);
@@ -1587,6 +3352,8 @@ void clearAllGraphs() {
     showEllipse = false;
     showParabola = false;
     showHyperbola = false;
+    showData = false;
+    showStream = false;
 }
 
 void iKeyboard(unsigned char key) {
@@ -1830,6 +3597,29 @@ void iKeyboard(unsigned char key) {
                     equationInput[0] = '\0';
                 }
             }
+            else if (strcmp(currentFunction, "data") == 0) {
+                success = loadDataSeries(equationInput, &dataSeries);
+                if (success) {
+                    showData = true;
+                    isEnteringEquation = false;
+                    equationInput[0] = '\0';
+                }
+            }
+            else if (strcmp(currentFunction, "stream") == 0) {
+                success = startStream(equationInput);
+                if (success) {
+                    showStream = true;
+                    isEnteringEquation = false;
+                    equationInput[0] = '\0';
+                }
+            }
+            else if (strcmp(currentFunction, "samples") == 0) {
+                success = exportSamples(equationInput);
+                if (success) {
+                    isEnteringEquation = false;
+                    equationInput[0] = '\0';
+                }
+            }
 
             if (!success) {
                 strcpy(equationInput, "Invalid equation! Press ESC to clear and try again");
@@ -1927,6 +3717,12 @@ void iKeyboard(unsigned char key) {
             case 'g':
                 showGridFlag = !showGridFlag;
                 break;
+            case 'd':
+                showDerivatives = !showDerivatives;
+                break;
+            case 't':
+                showTangent = false;
+                break;
             case '[':
                 if (scaleX < MAX_SCALE && scaleY < MAX_SCALE) {
                     scaleX *= 1.1;
@@ -1941,6 +3737,29 @@ void iKeyboard(unsigned char key) {
                     step *= 1.1;
                 }
                 break;
+            case 'o':
+                strcpy(currentFunction, "data");
+                isEnteringEquation = true;
+                break;
+            case 'i':
+                if (stream.running) {
+                    showStream = !showStream;
+                } else {
+                    strcpy(currentFunction, "stream");
+                    isEnteringEquation = true;
+                }
+                break;
+            case 'f':
+                streamFollow = !streamFollow;
+                break;
+            case 'v':
+                exportView();
+                break;
+            case 'w':
+                strcpy(currentFunction, "samples");
+                exportStatus[0] = '\0';
+                isEnteringEquation = true;
+                break;
             case 'x':
                 clearAllGraphs();
                 break;
@@ -1958,11 +3777,16 @@ void iMouse(int button, int state, int mx, int my) {
         lastMouseY = my;
     } else if (button == GLUT_LEFT_BUTTON && state == GLUT_UP) {
         isPanning = false;
+    } else if (button == GLUT_RIGHT_BUTTON && state == GLUT_DOWN) {
+        // Drop the tangent probe at the clicked x
+        tangentX = (mx - WINDOW_WIDTH / 2) / scaleX - offsetX;
+        showTangent = true;
     }
 }
 
 void iMouseMove(int mx, int my) {
     if (isPanning) {
+        streamFollow = false;   // the user takes over the view; 'f' follows the stream again
         offsetX += (mx - lastMouseX) / scaleX;  
         offsetY += (my - lastMouseY) / scaleY; 
         lastMouseX = mx;
@@ -1991,13 +3815,17 @@ void iSpecialKeyboard(unsigned char key) {
 
 void iDraw() {
     iClear();       // Clear the screen
+    followStream(); // Scroll to the newest streamed point before drawing
     drawAxes();     // Draw axes and grid
     plotFunctions(); // Plot mathematical functions
     drawUI();       // Draw user interface elements
 }
 
 // Main function
-int main() {
+int main(int argc, char **argv) {
+    // "--render jobs.txt" draws the jobs to image files and never opens a window
+    if (argc == 3 && strcmp(argv[1], "--render") == 0) return renderJobFile(argv[2]);
+
     iInitialize(WINDOW_WIDTH, WINDOW_HEIGHT, "Graph Plotter with Enhanced Functionality");
 
     return 0;